@@ -58,6 +58,7 @@ sub new {
     $self->{_can_nest} = 0;
     $self->{_unroll_args} = 1;
     $self->{_unroll_target} = 0;
+    $self->{_has_jacobian} = 0;
 
     bless $self, $class;    
     return $self;
@@ -85,6 +86,7 @@ sub clone {
     $clone->{_can_nest} = $self->can_nest;
     $clone->{_unroll_args} = $self->unroll_args;
     $clone->{_unroll_target} = $self->unroll_target;
+    $clone->{_has_jacobian} = $self->has_jacobian;
     
     bless $clone, ref($self);
     return $clone; 
@@ -476,6 +478,27 @@ sub set_is_inplace {
     $self->{_is_inplace} = $on;
 }
 
+=item B<has_jacobian>
+
+Should code be generated for the Jacobian of the action?
+
+=cut
+sub has_jacobian {
+    my $self = shift;
+    return $self->{_has_jacobian};
+}
+
+=item B<set_has_jacobian>(I<on>)
+
+Should code be generated for the Jacobian of the action?
+
+=cut
+sub set_has_jacobian {
+    my $self = shift;
+    my $on = shift;
+    $self->{_has_jacobian} = $on;
+}
+
 =item B<can_nest>
 
 Can the action be nested within other actions?
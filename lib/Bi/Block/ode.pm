@@ -59,6 +59,13 @@ An order 5(4) Dormand-Prince with adaptive step size.
 
 An order 4(3) low-storage Runge-Kutta with adaptive step size.
 
+=item C<'ROS3P'>
+
+An order 3(2) linearly implicit Rosenbrock method with adaptive step size,
+for stiff systems. Each step requires the Jacobian of the system, which is
+differentiated symbolically and generated as code, and the solution of linear
+systems of the same size. Available on host only.
+
 =back
 
 =item C<h> (position 1, default 1.0)
@@ -106,7 +113,8 @@ sub validate {
     $self->process_args($BLOCK_ARGS);
     
     my $alg = $self->get_named_arg('alg')->eval_const;
-    if ($alg ne 'RK4' && $alg ne 'RK5(4)' && $alg ne 'RK4(3)') {
+    if ($alg ne 'RK4' && $alg ne 'RK5(4)' && $alg ne 'RK4(3)' &&
+        $alg ne 'ROS3P') {
         die("unrecognised value '$alg' for argument 'alg' of block 'ode'\n");
     }
     
@@ -114,6 +122,7 @@ sub validate {
         if ($action->get_name ne 'ode_') {
             die("an 'ode' block may only contain ordinary differential equation actions\n");
         }
+        $action->set_has_jacobian($alg eq 'ROS3P');
     }
 }
 
@@ -71,6 +71,19 @@ Enable CUDA code.
 
 Enable SSE code.
 
+=item C<--enable-avx> (default off)
+
+Enable AVX code, using 512-bit registers if the host supports AVX-512, and
+256-bit registers otherwise. Code is compiled for the host on which it is
+built, so may not run on other hosts. Implies C<--enable-sse>, which is
+used for any methods without AVX code.
+
+=item C<--enable-philox> (default off)
+
+Use the counter-based Philox pseudorandom number generator on host, rather
+than the Mersenne Twister. Random variates for each particle are then
+independent of the number of threads.
+
 =item C<--enable-mpi> (default off)
 
 Enable MPI code.
@@ -133,6 +146,8 @@ sub new {
         _openmp => 1,
         _cuda => 0,
         _sse => 0,
+        _avx => 0,
+        _philox => 0,
         _mpi => 0,
         _vampir => 0,
         _single => 0,
@@ -158,6 +173,10 @@ sub new {
         'disable-cuda' => sub { $self->{_cuda} = 0 },
         'enable-sse' => sub { $self->{_sse} = 1 },
         'disable-sse' => sub { $self->{_sse} = 0 },
+        'enable-avx' => sub { $self->{_avx} = 1 },
+        'disable-avx' => sub { $self->{_avx} = 0 },
+        'enable-philox' => sub { $self->{_philox} = 1 },
+        'disable-philox' => sub { $self->{_philox} = 0 },
         'enable-mpi' => sub { $self->{_mpi} = 1 },
         'disable-mpi' => sub { $self->{_mpi} = 0 },
         'enable-vampir' => sub { $self->{_vampir} = 1 },
@@ -180,6 +199,15 @@ sub new {
     	warn("SSE has been disabled, unsupported when CUDA also enabled\n");
     	$self->{_sse} = 0;
     }
+    if ($self->{_cuda} && $self->{_avx}) {
+    	warn("AVX has been disabled, unsupported when CUDA also enabled\n");
+    	$self->{_avx} = 0;
+    }
+    
+    # AVX falls back to SSE for methods without AVX code
+    if ($self->{_avx}) {
+        $self->{_sse} = 1;
+    }
     
     # enable mpirun automatically when --enable-mpi used
     if ($self->{_mpi}) {
@@ -192,6 +220,8 @@ sub new {
     push(@builddir, 'openmp') if $self->{_openmp};
     push(@builddir, 'cuda') if $self->{_cuda};
     push(@builddir, 'sse') if $self->{_sse};
+    push(@builddir, 'avx') if $self->{_avx};
+    push(@builddir, 'philox') if $self->{_philox};
     push(@builddir, 'mpi') if $self->{_mpi};
     push(@builddir, 'vampir') if $self->{_vampir};
     push(@builddir, 'single') if $self->{_single};
@@ -312,6 +342,8 @@ sub _configure {
     $options .= $self->{_openmp} ? ' --enable-openmp' : ' --disable-openmp';
     $options .= $self->{_cuda} ? ' --enable-cuda' : ' --disable-cuda';
     $options .= $self->{_sse} ? ' --enable-sse' : ' --disable-sse';
+    $options .= $self->{_avx} ? ' --enable-avx' : ' --disable-avx';
+    $options .= $self->{_philox} ? ' --enable-philox' : ' --disable-philox';
     $options .= $self->{_mpi} ? ' --enable-mpi' : ' --disable-mpi';
     $options .= $self->{_vampir} ? ' --enable-vampir' : ' --disable-vampir';
     $options .= $self->{_single} ? ' --enable-single' : ' --disable-single';
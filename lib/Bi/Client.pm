@@ -94,6 +94,50 @@ File from which to read observations.
 
 File to which to write output. The default is C<results/I<command>.nc>.
 
+=item C<--output-flush-interval> (default 1)
+
+Number of consecutive output times to accumulate in memory before writing
+them to C<--output-file> together. Larger values give fewer, larger writes,
+at the cost of holding that many copies of the state in memory.
+
+=item C<--output-chunking> (default C<'default'>)
+
+Chunking of variables in C<--output-file> along the time and sample
+dimensions; one of:
+
+=over 8
+
+=item C<'default'>
+
+to leave chunking to NetCDF,
+
+=item C<'time'>
+
+for chunks of one time and many samples, favouring writes,
+
+=item C<'trajectory'>
+
+for chunks of many times and one sample, favouring reads of individual
+trajectories after the run, or
+
+=item C<'balanced'>
+
+for chunks of about as many times as samples.
+
+=back
+
+Chunks are around 1 MB in size.
+
+=item C<--output-deflate> (default 0)
+
+Deflate level for compression of variables in C<--output-file>, from 0 (no
+compression) to 9.
+
+=item C<--with-output-shuffle> (default on)
+
+Apply the shuffle filter before deflate, which usually improves compression
+of floating point values.
+
 =item C<--init-ns> (default 0)
 
 Index along the C<ns> dimension of C<--init-file> to use.
@@ -121,6 +165,13 @@ Index along the C<ns> dimension of C<--obs-file> to use.
 
 Index along the C<np> dimension of C<--obs-file> to use.
 
+=item C<--with-input-preload> (default off)
+
+Load the whole of C<--input-file> and C<--obs-file> into memory on startup,
+so that they are not read again during the run. This suits methods that
+pass over the same inputs and observations many times, such as C<sample>,
+at the cost of memory.
+
 =back
 
 =head2 Model transformations
@@ -207,6 +258,26 @@ our @CLIENT_OPTIONS = (
       name => 'output-file',
       type => 'string'
     },
+    {
+      name => 'output-flush-interval',
+      type => 'int',
+      default => 1
+    },
+    {
+      name => 'output-chunking',
+      type => 'string',
+      default => 'default'
+    },
+    {
+      name => 'output-deflate',
+      type => 'int',
+      default => 0
+    },
+    {
+      name => 'with-output-shuffle',
+      type => 'bool',
+      default => 1
+    },
     {
       name => 'init-ns',
       type => 'int',
@@ -237,6 +308,11 @@ our @CLIENT_OPTIONS = (
       type => 'int',
       default => 0
     },
+    {
+      name => 'with-input-preload',
+      type => 'bool',
+      default => 0
+    },
     {
       name => 'seed',
       type => 'int',
@@ -0,0 +1,97 @@
+=head1 NAME
+
+convert - convert output files between NetCDF and memory-mapped formats.
+
+=head1 SYNOPSIS
+
+    libbi convert --model-file I<Model>.bi --from-file I<results>.nc \
+        --to-file I<results>.mm --schema filter
+
+    libbi convert --model-file I<Model>.bi --from-file I<results>.mm \
+        --to-file I<results>.nc --schema filter --to-format netcdf
+
+=head1 DESCRIPTION
+
+The C<convert> command copies an output file of the simulation or particle
+filter schema to a memory-mapped file of fixed layout, or back again. A
+memory-mapped file holds each variable type at each time as a contiguous,
+column-major block of all samples, in the native byte order and precision
+of the build, so that other programs may map it and read it directly,
+without a NetCDF library. Files of the ``flexi'' schemas cannot be
+converted.
+
+Give the same model, and the same model transformation options, as the
+command that produced the file, so that the variables match.
+
+=cut
+
+package Bi::Client::convert;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+=over 4
+
+=item C<--from-file>
+
+File to convert.
+
+=item C<--to-file>
+
+File to create. Any existing file of the same name is replaced.
+
+=item C<--to-format> (default C<'mmap'>)
+
+Format of C<--to-file>, either C<'mmap'> for a memory-mapped file, with
+C<--from-file> a NetCDF file, or C<'netcdf'> for a NetCDF file, with
+C<--from-file> a memory-mapped file.
+
+=item C<--schema> (default C<'simulator'>)
+
+Schema of C<--from-file>, either C<'simulator'> to convert times,
+parameters and state only, or C<'filter'> to also convert log-weights,
+ancestors and the marginal log-likelihood estimate of a particle filter.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'from-file',
+      type => 'string'
+    },
+    {
+      name => 'to-file',
+      type => 'string'
+    },
+    {
+      name => 'to-format',
+      type => 'string',
+      default => 'mmap'
+    },
+    {
+      name => 'schema',
+      type => 'string',
+      default => 'simulator'
+    }
+);
+
+sub init {
+    my $self = shift;
+
+    $self->{_binary} = 'convert';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
+
+=head1 VERSION
+
+$Rev$ $Date$
@@ -97,6 +97,23 @@ Threshold for effective sample size (ESS) resampling trigger. Particles will
 only be resampled if ESS is below this proportion of C<--nparticles>. To
 always resample, use C<--ess-rel 1>. To never resample, use C<--ess-rel 0>.
 
+=item C<--tile-size> (default 0)
+
+Number of particles per tile for tiled execution of the bootstrap particle
+filter on host. With a nonzero tile size, particles are processed in tiles
+that remain in cache through resampling, prediction and correction, rather
+than the whole population being swept at each of these stages. This requires
+the C<stratified>, C<systematic>, C<multinomial>, C<metropolis> or
+C<rejection> resampler, and a build with C<--enable-philox>, with which
+results are identical to those without tiling. Zero disables tiling.
+
+
+=item C<--output-format> (default C<netcdf>)
+
+Format of the output file; one of C<netcdf>, or C<mmap> for the
+memory-mapped format of fixed layout that C<convert> reads and writes.
+The latter is only available to the C<filter> command with C<--filter pf>.
+Input files are always NetCDF.
 
 =item C<--resampler> (default C<systematic>)
 
@@ -257,6 +274,16 @@ our @CLIENT_OPTIONS = (
       type => 'float',
       default => 0.5
     },
+    {
+      name => 'tile-size',
+      type => 'int',
+      default => 0
+    },
+    {
+      name => 'output-format',
+      type => 'string',
+      default => 'netcdf'
+    },
     {
       name => 'resampler',
       type => 'string',
@@ -347,6 +374,13 @@ sub process_args {
     } else {
         $binary = 'pf';
     }
+    my $format = $self->get_named_arg('output-format');
+    if ($format ne 'netcdf' && $format ne 'mmap') {
+        die("unrecognised output format '$format'\n");
+    }
+    if ($format eq 'mmap' && $filter ne 'pf') {
+        die("--output-format mmap is only available with --filter pf\n");
+    }
     $self->{_binary} = $binary;
 }
 
@@ -127,6 +127,9 @@ sub process_args {
     my $self = shift;
 
     $self->Bi::Client::filter::process_args(@_);
+    if ($self->get_named_arg('output-format') ne 'netcdf') {
+        die("--output-format is only available with the filter command\n");
+    }
     my $binary = $self->get_named_arg('optimiser');
     if ($self->is_named_arg('optimizer') && $self->is_named_arg('optimizer') ne '') {
         # alternate spelling used
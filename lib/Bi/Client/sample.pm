@@ -194,6 +194,9 @@ sub process_args {
     my $self = shift;
 
     $self->Bi::Client::filter::process_args(@_);
+    if ($self->get_named_arg('output-format') ne 'netcdf') {
+        die("--output-format is only available with the filter command\n");
+    }
     
     # work out client program
     my $target = $self->get_named_arg('target');
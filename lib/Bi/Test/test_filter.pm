@@ -0,0 +1,107 @@
+=head1 NAME
+
+test_filter - test tiled particle filter against untiled.
+
+=head1 SYNOPSIS
+
+    libbi test_filter --model-file I<model>.bi --enable-philox ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=cut
+
+package Bi::Test::test_filter;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+Runs the bootstrap particle filter twice from the same seed, first without
+and then with tiling, and compares the marginal log-likelihood estimates,
+which should be identical. Exits with nonzero status if they are not. Use
+a model with noise terms, so that the order in which variates are drawn is
+put to the test, and build with C<--enable-philox>, which tiling requires.
+
+=over 4
+
+=item C<--start-time> (default 0.0)
+
+Start time.
+
+=item C<--end-time> (default 0.0)
+
+End time.
+
+=item C<--noutputs> (default 0)
+
+Number of dense output times.
+
+=item C<--nparticles> (default 1024)
+
+Number of particles to use.
+
+=item C<--ess-rel> (default 1.0)
+
+Threshold for effective sample size (ESS) resampling trigger, by default
+resampling at every observation, so that tiles are gathered at every step.
+
+=item C<--tile-size> (default 64)
+
+Number of particles per tile.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'start-time',
+      type => 'float',
+      default => 0.0
+    },
+    {
+      name => 'end-time',
+      type => 'float',
+      default => 0.0
+    },
+    {
+      name => 'noutputs',
+      type => 'int',
+      default => 0
+    },
+    {
+      name => 'nparticles',
+      type => 'int',
+      default => 1024
+    },
+    {
+      name => 'ess-rel',
+      type => 'float',
+      default => 1.0
+    },
+    {
+      name => 'tile-size',
+      type => 'int',
+      default => 64
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_filter';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
+
+=head1 VERSION
+
+$Rev$ $Date$
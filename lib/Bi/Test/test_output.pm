@@ -0,0 +1,79 @@
+=head1 NAME
+
+test_output - benchmark output throughput.
+
+=head1 SYNOPSIS
+
+    libbi test_output --model-file I<model>.bi ...
+
+=head1 INHERITS
+
+L<Bi::Client>
+
+=cut
+
+package Bi::Test::test_output;
+
+use parent 'Bi::Client';
+use warnings;
+use strict;
+
+=head1 OPTIONS
+
+Writes random state for all samples at all times to C<--output-file>, as
+a simulation would, then reads it back both one time at a time and one
+trajectory at a time, reporting the time taken for each. Combine with
+C<--output-chunking>, C<--output-deflate>, C<--with-output-shuffle> and
+C<--output-flush-interval> to compare output settings.
+
+=over 4
+
+=item C<--nsamples> (default 1024)
+
+Number of samples.
+
+=item C<--ntimes> (default 256)
+
+Number of output times.
+
+=item C<--ntrajectories> (default 16)
+
+Number of trajectories to read back.
+
+=back
+
+=cut
+our @CLIENT_OPTIONS = (
+    {
+      name => 'nsamples',
+      type => 'int',
+      default => 1024
+    },
+    {
+      name => 'ntimes',
+      type => 'int',
+      default => 256
+    },
+    {
+      name => 'ntrajectories',
+      type => 'int',
+      default => 16
+    }
+);
+
+sub init {
+    my $self = shift;
+
+	$self->{_binary} = 'test_output';
+    push(@{$self->{_params}}, @CLIENT_OPTIONS);
+}
+
+1;
+
+=head1 AUTHOR
+
+Lawrence Murray <lawrence.murray@csiro.au>
+
+=head1 VERSION
+
+$Rev$ $Date$
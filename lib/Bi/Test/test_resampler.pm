@@ -44,6 +44,17 @@ for a Metropolis resampler (Murray 2011),
 
 for a rejection resampler, or
 
+=item C<'copy'>
+
+to time only the in-place copy of particles after stratified resampling,
+or
+
+=item C<'permute'>
+
+to time only the conversion of cumulative offspring to permuted ancestry
+in stratified resampling. Run with different C<--threads> to assess
+scaling.
+
 =back
 
 =item C<--Zs> (default 5)
@@ -66,6 +77,10 @@ Sort weights prior to resampling.
 
 Number of steps to take for Metropolis resampler.
 
+=item C<--dims> (default 64)
+
+Number of variables per particle for C<--resampler copy>.
+
 =back
 
 =cut
@@ -99,6 +114,11 @@ our @CLIENT_OPTIONS = (
       name => 'C',
       type => 'int',
       default => 0
+    },
+    {
+      name => 'dims',
+      type => 'int',
+      default => 64
     }
 );
 
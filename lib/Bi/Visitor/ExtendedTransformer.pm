@@ -297,6 +297,7 @@ sub _create_jacobian_actions {
                 if ($node->get_name eq 'ode_') {
                  	$action->set_op('=');
                    	$action->set_right(new Bi::Expression::Function('ode_', [ $right ]));
+                 	$action->set_has_jacobian($node->has_jacobian);
                 } else {
                     $action->set_op('<-');
                     $action->set_right($right);
@@ -0,0 +1,304 @@
+/**
+ * @file
+ *
+ * Functions for reading of state objects through main memory for SSE
+ * instructions. Use host.hpp methods to bind.
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_AVXHOST_HPP
+#define BI_AVX_AVXHOST_HPP
+
+#include "math/scalar.hpp"
+#include "../host/host.hpp"
+
+namespace bi {
+/**
+ * Facade for state as 256- or 512-bit AVX values in main memory.
+ *
+ * @ingroup state_host
+ */
+struct avx_host {
+  typedef avx_real value_type;
+  typedef host_vector_reference<avx_real> vector_reference_type;
+  typedef typename host::vector_reference_alt_type vector_reference_alt_type;
+
+  static const bool on_device = false;
+
+  /**
+   * Fetch variable.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   *
+   * @return Variable.
+   */
+  template<class B, class X>
+  static vector_reference_type fetch(State<B,ON_HOST>& s, const int p);
+
+  /**
+   * Fetch variable from alternative buffer.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   *
+   * @return Value of the given variable.
+   */
+  template<class B, class X>
+  static vector_reference_alt_type fetch_alt(State<B,ON_HOST>& s,
+      const int p);
+
+  /**
+   * Fetch variable.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   *
+   * @return Variable.
+   */
+  template<class B, class X>
+  static vector_reference_type fetch(const State<B,ON_HOST>& s, const int p);
+
+  /**
+   * Fetch variable from alternative buffer.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   *
+   * @return Value of the given variable.
+   */
+  template<class B, class X>
+  static vector_reference_alt_type fetch_alt(const State<B,ON_HOST>& s,
+      const int p);
+
+  /**
+   * Fetch variable.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   * @param ix Serial coordinate.
+   *
+   * @return Variable.
+   */
+  template<class B, class X>
+  static avx_real& fetch(State<B,ON_HOST>& s, const int p, const int ix);
+
+  /**
+   * Fetch variable from alternative buffer.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   * @param ix Serial coordinate.
+   *
+   * @return Value of the given variable.
+   */
+  template<class B, class X>
+  static bi::avx_real& fetch_alt(State<B,ON_HOST>& s, const int p,
+      const int ix);
+
+  /**
+   * Fetch variable.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   * @param ix Serial coordinate.
+   *
+   * @return Variable.
+   */
+  template<class B, class X>
+  static const avx_real& fetch(const State<B,ON_HOST>& s, const int p,
+      const int ix);
+
+  /**
+   * Fetch variable from alternative buffer.
+   *
+   * @ingroup state_host
+   *
+   * @tparam B Model type.
+   * @tparam X Variable type.
+   *
+   * @param s State.
+   * @param p Trajectory id.
+   * @param ix Serial coordinate.
+   *
+   * @return Value of the given variable.
+   */
+  template<class B, class X>
+  static const bi::avx_real& fetch_alt(const State<B,ON_HOST>& s, const int p,
+      const int ix);
+};
+
+/**
+ * Load targets from state into contiguous vector.
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ * @tparam V1 Vector type.
+ *
+ * @param s State.
+ * @param p Trajectory id.
+ * @param[out] x Vector.
+ */
+template<class B, class S, class V1>
+void avx_host_load(State<B,ON_HOST>& s, const int p, V1 x);
+
+/**
+ * Store targets from contiguous vector into state.
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ *
+ * @param s[out] State.
+ * @param p Trajectory id.
+ * @param x Vector.
+ */
+template<class B, class S, class V1>
+void avx_host_store(State<B,ON_HOST>& s, const int p, const V1 x);
+
+/**
+ * Number of trajectories that may be processed with AVX instructions.
+ *
+ * @tparam B Model type.
+ *
+ * @param s State.
+ *
+ * @return Largest multiple of #BI_AVX_SIZE not greater than the number of
+ * trajectories in the active range of @p s, or zero if the start of that
+ * range is not aligned. The remaining tail of the range should be
+ * processed without AVX instructions.
+ */
+template<class B>
+int avx_host_size(const State<B,ON_HOST>& s);
+
+}
+
+#include "avx_host_load_visitor.hpp"
+#include "avx_host_store_visitor.hpp"
+
+template<class B>
+inline int bi::avx_host_size(const State<B,ON_HOST>& s) {
+  if (s.start() % BI_AVX_SIZE == 0) {
+    return s.size() - s.size() % BI_AVX_SIZE;
+  } else {
+    return 0;
+  }
+}
+
+template<class B, class X>
+inline bi::avx_host::vector_reference_type bi::avx_host::fetch(
+    State<B,ON_HOST>& s, const int p) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var<X>::value);
+
+  BOOST_AUTO(x, row(s.template getVar<X>(), p));
+  return vector_reference_type(reinterpret_cast<avx_real*>(x.buf()), x.size(),
+      x.inc()/BI_AVX_SIZE);
+}
+
+template<class B, class X>
+inline bi::avx_host::vector_reference_alt_type bi::avx_host::fetch_alt(
+    State<B,ON_HOST>& s, const int p) {
+  return host::template fetch_alt<B,X>(s, p);
+}
+
+template<class B, class X>
+inline bi::avx_host::vector_reference_type bi::avx_host::fetch(
+    const State<B,ON_HOST>& s, const int p) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var<X>::value);
+
+  BOOST_AUTO(x, row(s.template getVar<X>(), p));
+  return vector_reference_type(reinterpret_cast<avx_real*>(x.buf()), x.size(),
+      x.inc()/BI_AVX_SIZE);
+}
+
+template<class B, class X>
+inline bi::avx_host::vector_reference_alt_type bi::avx_host::fetch_alt(
+    const State<B,ON_HOST>& s, const int p) {
+  return host::template fetch_alt<B,X>(s, p);
+}
+
+template<class B, class X>
+inline bi::avx_real& bi::avx_host::fetch(State<B,ON_HOST>& s, const int p,
+    const int ix) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var<X>::value);
+
+  return *reinterpret_cast<avx_real*>(&s.template getVar<X>(p, ix));
+}
+
+template<class B, class X>
+inline bi::avx_real& bi::avx_host::fetch_alt(State<B,ON_HOST>& s, const int p,
+    const int ix) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var_alt<X>::value);
+
+  return *reinterpret_cast<const avx_real*>(&s.template getVarAlt<X>(p, ix));
+}
+
+template<class B, class X>
+inline const bi::avx_real& bi::avx_host::fetch(const State<B,ON_HOST>& s,
+    const int p, const int ix) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var<X>::value);
+
+  return *reinterpret_cast<const avx_real*>(&s.template getVar<X>(p, ix));
+}
+
+template<class B, class X>
+inline const bi::avx_real& bi::avx_host::fetch_alt(const State<B,ON_HOST>& s,
+    const int p, const int ix) {
+  /* pre-condition */
+  BI_ASSERT(!is_common_var_alt<X>::value);
+
+  return *reinterpret_cast<const avx_real*>(&s.template getVarAlt<X>(p, ix));
+}
+
+template<class B, class S, class V1>
+inline void bi::avx_host_load(State<B,ON_HOST>& s, const int p, V1 x) {
+  avx_host_load_visitor<B,S,S>::accept(s, p, x);
+}
+
+template<class B, class S, class V1>
+inline void bi::avx_host_store(State<B,ON_HOST>& s, const int p, const V1 x) {
+  avx_host_store_visitor<B,S,S>::accept(s, p, x);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_AVXHOSTSTOREVISITOR_HPP
+#define BI_AVX_AVXHOSTSTOREVISITOR_HPP
+
+namespace bi {
+/**
+ * Visitor for avx_host_store.
+ *
+ * @tparam B Model type.
+ * @tparam S1 Action type list, giving targets in block.
+ * @tparam S2 Action type list.
+ */
+template<class B, class S1, class S2>
+class avx_host_store_visitor {
+public:
+  /**
+   * Accept.
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param s[in,out] State.
+   * @param p Trajectory id.
+   * @param x Vector.
+   */
+  template<class V1>
+  static void accept(State<B,ON_HOST>& s, const int p, const V1 x);
+};
+
+/**
+ * @internal
+ *
+ * Base case of avx_host_store_visitor.
+ */
+template<class B, class S1>
+class avx_host_store_visitor<B,S1,empty_typelist> {
+public:
+  template<class V1>
+  static void accept(State<B,ON_HOST>& s, const int p, const V1 x) {
+    //
+  }
+};
+}
+
+#include "../typelist/front.hpp"
+#include "../typelist/pop_front.hpp"
+#include "../traits/target_traits.hpp"
+#include "../math/view.hpp"
+
+template<class B, class S1, class S2>
+template<class V1>
+inline void bi::avx_host_store_visitor<B,S1,S2>::accept(
+    State<B,ON_HOST>& s, const int p, const V1 x) {
+  typedef typename front<S2>::type front;
+  typedef typename pop_front<S2>::type pop_front;
+  typedef typename front::target_type target_type;
+  typedef typename front::coord_type coord_type;
+
+  int ix = 0;
+  coord_type cox;
+  while (ix < action_size<front>::value) {
+    avx_host::fetch<B,target_type>(s, p)(cox.index()) = x(action_start<S1,front>::value + ix);
+    ++cox;
+    ++ix;
+  }
+  avx_host_store_visitor<B,S1,pop_front>::accept(s, p, x);
+}
+
+#endif
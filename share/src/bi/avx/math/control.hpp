@@ -0,0 +1,56 @@
+/**
+ * @file
+ *
+ * Control functions for expressions.
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_MATH_CONTROL_HPP
+#define BI_AVX_MATH_CONTROL_HPP
+
+#include "scalar.hpp"
+
+namespace bi {
+/**
+ * Conditional.
+ *
+ * @param mask Mask, giving 0x0 for false value, OxF..F for true value.
+ * @param o1 Values to assume for true components.
+ * @param o2 Values to assume for false components.
+ */
+avx_real avx_if(const avx_real& mask, const avx_real& o1,
+    const avx_real& o2);
+
+/**
+ * Any.
+ *
+ * @return True if any mask components are true, false otherwise.
+ */
+bool avx_any(const avx_real& mask);
+
+/**
+ * All.
+ *
+ * @return True if all mask components are true, false otherwise.
+ */
+bool avx_all(const avx_real& mask);
+
+}
+
+inline bi::avx_real bi::avx_if(const bi::avx_real& mask,
+    const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_ADD_P(BI_AVX_AND_P(mask.packed, o1.packed),
+      BI_AVX_ANDNOT_P(mask.packed, o2.packed));
+}
+
+inline bool bi::avx_any(const bi::avx_real& mask) {
+  return BI_AVX_ANY_P(mask.packed);
+}
+
+inline bool bi::avx_all(const bi::avx_real& mask) {
+  return BI_AVX_ALL_P(mask.packed);
+}
+
+#endif
@@ -0,0 +1,352 @@
+/**
+ * @file
+ *
+ * Functions for Advanced Vector Extensions (AVX).
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_MATH_FUNCTION_HPP
+#define BI_AVX_MATH_FUNCTION_HPP
+
+#include "scalar.hpp"
+
+/**
+ * @def BI_AVX_UNIVARIATE
+ *
+ * Macro for creating AVX math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX_UNIVARIATE(func, x) \
+    avx_real res; \
+    for (int i = 0; i < BI_AVX_SIZE; ++i) { \
+      res.unpacked[i] = bi::func(x.unpacked[i]); \
+    } \
+    return res;
+
+/**
+ * @def BI_AVX_BIVARIATE
+ *
+ * Macro for creating AVX math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX_BIVARIATE(func, x1, x2) \
+    avx_real res; \
+    for (int i = 0; i < BI_AVX_SIZE; ++i) { \
+      res.unpacked[i] = bi::func(x1.unpacked[i], x2.unpacked[i]); \
+    } \
+    return res;
+
+/**
+ * @def BI_AVX_BIVARIATE_REAL_RIGHT
+ *
+ * Macro for creating AVX math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX_BIVARIATE_REAL_RIGHT(func, x1, x2) \
+    avx_real res; \
+    for (int i = 0; i < BI_AVX_SIZE; ++i) { \
+      res.unpacked[i] = bi::func(x1.unpacked[i], x2); \
+    } \
+    return res;
+
+/**
+ * @def BI_AVX_BIVARIATE_REAL_LEFT
+ *
+ * Macro for creating AVX math functions that must operate on individual
+ * elements.
+ */
+#define BI_AVX_BIVARIATE_REAL_LEFT(func, x1, x2) \
+    avx_real res; \
+    for (int i = 0; i < BI_AVX_SIZE; ++i) { \
+      res.unpacked[i] = bi::func(x1, x2.unpacked[i]); \
+    } \
+    return res;
+
+namespace bi {
+
+//double abs(const double x);
+avx_real abs(const bi::avx_real x);
+//double log(const double x);
+avx_real log(const bi::avx_real x);
+//double nanlog(const double x);
+avx_real nanlog(const bi::avx_real x);
+//double exp(const double x);
+avx_real exp(const bi::avx_real x);
+//double nanexp(const double x);
+avx_real nanexp(const bi::avx_real x);
+//double max(const double x, const double y);
+avx_real max(const bi::avx_real x, const bi::avx_real y);
+//double min(const double x, const double y);
+avx_real min(const bi::avx_real x, const bi::avx_real y);
+//double sqrt(const double x);
+avx_real sqrt(const bi::avx_real x);
+//double pow(const double x, const double y);
+avx_real pow(const bi::avx_real x, const bi::avx_real y);
+avx_real pow(const bi::avx_real x, const real y);
+avx_real pow(const real x, const bi::avx_real y);
+//double mod(const double x, const double y);
+avx_real mod(const bi::avx_real x, const bi::avx_real y);
+//double ceil(const double x);
+avx_real ceil(const bi::avx_real x);
+//double floor(const double x);
+avx_real floor(const bi::avx_real x);
+//double gamma(const double x);
+avx_real gamma(const bi::avx_real x);
+//double lgamma(const double x);
+avx_real lgamma(const bi::avx_real x);
+//double sin(const double x);
+avx_real sin(const bi::avx_real x);
+//double cos(const double x);
+avx_real cos(const bi::avx_real x);
+//double tan(const double x);
+avx_real tan(const bi::avx_real x);
+//double asin(const double x);
+avx_real asin(const bi::avx_real x);
+//double acos(const double x);
+avx_real acos(const bi::avx_real x);
+//double atan(const double x);
+avx_real atan(const bi::avx_real x);
+//double atan2(const double x, const double y);
+avx_real atan2(const bi::avx_real x, const bi::avx_real y);
+//double sinh(const double x);
+avx_real sinh(const bi::avx_real x);
+//double cosh(const double x);
+avx_real cosh(const bi::avx_real x);
+//double tanh(const double x);
+avx_real tanh(const bi::avx_real x);
+//double asinh(const double x);
+avx_real asinh(const bi::avx_real x);
+//double acosh(const double x);
+avx_real acosh(const bi::avx_real x);
+//double atanh(const double x);
+avx_real atanh(const bi::avx_real x);
+
+}
+
+//inline double bi::abs(const double x) {
+//  return ::fabs(x);
+//}
+
+inline bi::avx_real bi::abs(const bi::avx_real x) {
+  return BI_AVX_ANDNOT_P(BI_AVX_SET1_P(BI_REAL(-0.0)), x.packed);
+}
+
+//inline double bi::log(const double x) {
+//  return ::log(x);
+//}
+
+inline bi::avx_real bi::log(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(log, x)
+}
+
+//inline double bi::nanlog(const double x) {
+//  return isnan(x) ? log(0.0) : log(x);
+//}
+
+inline bi::avx_real bi::nanlog(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(nanlog, x)
+}
+
+//inline double bi::exp(const double x) {
+//  return ::exp(x);
+//}
+
+inline bi::avx_real bi::exp(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(exp, x)
+}
+
+//inline double bi::nanexp(const double x) {
+//  return isnan(x) ? exp(0.0) : exp(x);
+//}
+
+inline bi::avx_real bi::nanexp(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(nanexp, x)
+}
+
+//inline double bi::max(const double x, const double y) {
+//  return ::fmax(x, y);
+//}
+
+inline bi::avx_real bi::max(const bi::avx_real x, const bi::avx_real y) {
+  return BI_AVX_MAX_P(x.packed, y.packed);
+}
+
+//inline double bi::min(const double x, const double y) {
+//  return ::fmin(x, y);
+//}
+
+inline bi::avx_real bi::min(const bi::avx_real x, const bi::avx_real y) {
+  return BI_AVX_MIN_P(x.packed, y.packed);
+}
+
+//inline double bi::sqrt(const double x) {
+//  return ::sqrt(x);
+//}
+
+inline bi::avx_real bi::sqrt(const bi::avx_real x) {
+  return BI_AVX_SQRT_P(x.packed);
+}
+
+//inline double bi::pow(const double x, const double y) {
+//  return ::pow(x, y);
+//}
+
+inline bi::avx_real bi::pow(const bi::avx_real x, const bi::avx_real y) {
+  BI_AVX_BIVARIATE(pow, x, y)
+}
+
+inline bi::avx_real bi::pow(const bi::avx_real x, const real y) {
+  BI_AVX_BIVARIATE_REAL_RIGHT(pow, x, y)
+}
+
+inline bi::avx_real bi::pow(const real x, const bi::avx_real y) {
+  BI_AVX_BIVARIATE_REAL_LEFT(pow, x, y)
+}
+
+//inline double bi::mod(const double x, const double y) {
+//  return ::fmod(x, y);
+//}
+
+inline bi::avx_real bi::mod(const bi::avx_real x, const bi::avx_real y) {
+  BI_AVX_BIVARIATE(mod, x, y)
+}
+
+//inline double bi::ceil(const double x) {
+//  return ::ceil(x);
+//}
+
+inline bi::avx_real bi::ceil(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(ceil, x)
+}
+
+//inline double bi::floor(const double x) {
+//  return ::floor(x);
+//}
+
+inline bi::avx_real bi::floor(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(floor, x)
+}
+
+//inline double bi::gamma(const double x) {
+//  return ::tgamma(x);
+//}
+
+inline bi::avx_real bi::gamma(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(gamma, x)
+}
+
+//inline double bi::lgamma(const double x) {
+//  return ::lgamma(x);
+//}
+
+inline bi::avx_real bi::lgamma(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(lgamma, x)
+}
+
+//inline double bi::sin(const double x) {
+//  return ::sin(x);
+//}
+
+inline bi::avx_real bi::sin(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(sin, x)
+}
+
+//inline double bi::cos(const double x) {
+//  return ::cos(x);
+//}
+
+inline bi::avx_real bi::cos(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(cos, x)
+}
+
+//inline double bi::tan(const double x) {
+//  return ::tan(x);
+//}
+
+inline bi::avx_real bi::tan(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(tan, x)
+}
+
+//inline double bi::asin(const double x) {
+//  return ::asin(x);
+//}
+
+inline bi::avx_real bi::asin(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(asin, x)
+}
+
+//inline double bi::acos(const double x) {
+//  return ::acos(x);
+//}
+
+inline bi::avx_real bi::acos(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(acos, x)
+}
+
+//inline double bi::atan(const double x) {
+//  return ::atan(x);
+//}
+
+inline bi::avx_real bi::atan(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(atan, x)
+}
+
+//inline double bi::atan2(const double x, const double y) {
+//  return ::atan2(x, y);
+//}
+
+inline bi::avx_real bi::atan2(const bi::avx_real x, const bi::avx_real y) {
+  BI_AVX_BIVARIATE(atan2, x, y)
+}
+
+//inline double bi::sinh(const double x) {
+//  return ::sinh(x);
+//}
+
+inline bi::avx_real bi::sinh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(sinh, x)
+}
+
+//inline double bi::cosh(const double x) {
+//  return ::cosh(x);
+//}
+
+inline bi::avx_real bi::cosh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(cosh, x)
+}
+
+//inline double tanh(const double x) {
+//  return ::tanh(x);
+//}
+
+inline bi::avx_real bi::tanh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(tanh, x)
+}
+
+//inline double asinh(const double x) {
+//  return ::asinh(x);
+//}
+
+inline bi::avx_real bi::asinh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(asinh, x)
+}
+
+//inline double bi::acosh(const double x) {
+//  return ::acosh(x);
+//}
+
+inline bi::avx_real bi::acosh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(acosh, x)
+}
+
+//inline double atanh(const double x) {
+//  return ::atanh(x);
+//}
+
+inline bi::avx_real bi::atanh(const bi::avx_real x) {
+  BI_AVX_UNIVARIATE(atanh, x)
+}
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @file
+ *
+ * IO functions for AVX types.
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_MATH_IO_HPP
+#define BI_AVX_MATH_IO_HPP
+
+#include "scalar.hpp"
+
+#include <iostream>
+
+/**
+ * Output AVX value.
+ *
+ * @param X Host matrix.
+ */
+std::ostream& operator<<(std::ostream& stream, const bi::avx_real& x);
+
+inline std::ostream& operator<<(std::ostream& stream, const bi::avx_real& x) {
+  stream << '[' << x.unpacked[0];
+  for (int i = 1; i < BI_AVX_SIZE; ++i) {
+    stream << ',' << x.unpacked[i];
+  }
+  stream << ']';
+
+  return stream;
+}
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * @file
+ *
+ * Types and operators for Advanced Vector Extensions (AVX).
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_MATH_SCALAR_HPP
+#define BI_AVX_MATH_SCALAR_HPP
+
+#include "../../math/scalar.hpp"
+#include "../../misc/compile.hpp"
+
+#include <immintrin.h>
+
+#if !defined(__AVX__)
+#error "--enable-avx requires a compiler target with AVX support"
+#endif
+
+/**
+ * @def BI_AVX_SIZE
+ *
+ * Number of packed elements in an avx_real variable. When the compiler
+ * targets AVX-512, 512-bit registers are used, otherwise 256-bit
+ * registers.
+ */
+#ifdef __AVX512F__
+#ifdef ENABLE_SINGLE
+#define BI_AVX_SIZE 16
+#else
+#define BI_AVX_SIZE 8
+#endif
+#else
+#ifdef ENABLE_SINGLE
+#define BI_AVX_SIZE 8
+#else
+#define BI_AVX_SIZE 4
+#endif
+#endif
+
+/*
+ * Function aliases.
+ */
+#ifdef __AVX512F__
+#ifdef ENABLE_SINGLE
+#define BI_AVX_PACKED __m512
+#define BI_AVX_ADD_P _mm512_add_ps
+#define BI_AVX_SUB_P _mm512_sub_ps
+#define BI_AVX_MUL_P _mm512_mul_ps
+#define BI_AVX_DIV_P _mm512_div_ps
+#define BI_AVX_SQRT_P _mm512_sqrt_ps
+#define BI_AVX_MAX_P _mm512_max_ps
+#define BI_AVX_MIN_P _mm512_min_ps
+#define BI_AVX_LOAD_P _mm512_load_ps
+#define BI_AVX_STORE_P _mm512_store_ps
+#define BI_AVX_SET1_P _mm512_set1_ps
+#define BI_AVX_CMP_P(x, y, op) _mm512_castsi512_ps(_mm512_maskz_set1_epi32( \
+    _mm512_cmp_ps_mask(x, y, op), -1))
+#define BI_AVX_AND_P(x, y) _mm512_castsi512_ps(_mm512_and_si512( \
+    _mm512_castps_si512(x), _mm512_castps_si512(y)))
+#define BI_AVX_ANDNOT_P(x, y) _mm512_castsi512_ps(_mm512_andnot_si512( \
+    _mm512_castps_si512(x), _mm512_castps_si512(y)))
+#define BI_AVX_XOR_P(x, y) _mm512_castsi512_ps(_mm512_xor_si512( \
+    _mm512_castps_si512(x), _mm512_castps_si512(y)))
+#define BI_AVX_ANY_P(x) (_mm512_test_epi32_mask(_mm512_castps_si512(x), \
+    _mm512_castps_si512(x)) != 0)
+#define BI_AVX_ALL_P(x) (_mm512_test_epi32_mask(_mm512_castps_si512(x), \
+    _mm512_castps_si512(x)) == 0xFFFF)
+#else
+#define BI_AVX_PACKED __m512d
+#define BI_AVX_ADD_P _mm512_add_pd
+#define BI_AVX_SUB_P _mm512_sub_pd
+#define BI_AVX_MUL_P _mm512_mul_pd
+#define BI_AVX_DIV_P _mm512_div_pd
+#define BI_AVX_SQRT_P _mm512_sqrt_pd
+#define BI_AVX_MAX_P _mm512_max_pd
+#define BI_AVX_MIN_P _mm512_min_pd
+#define BI_AVX_LOAD_P _mm512_load_pd
+#define BI_AVX_STORE_P _mm512_store_pd
+#define BI_AVX_SET1_P _mm512_set1_pd
+#define BI_AVX_CMP_P(x, y, op) _mm512_castsi512_pd(_mm512_maskz_set1_epi64( \
+    _mm512_cmp_pd_mask(x, y, op), -1))
+#define BI_AVX_AND_P(x, y) _mm512_castsi512_pd(_mm512_and_si512( \
+    _mm512_castpd_si512(x), _mm512_castpd_si512(y)))
+#define BI_AVX_ANDNOT_P(x, y) _mm512_castsi512_pd(_mm512_andnot_si512( \
+    _mm512_castpd_si512(x), _mm512_castpd_si512(y)))
+#define BI_AVX_XOR_P(x, y) _mm512_castsi512_pd(_mm512_xor_si512( \
+    _mm512_castpd_si512(x), _mm512_castpd_si512(y)))
+#define BI_AVX_ANY_P(x) (_mm512_test_epi64_mask(_mm512_castpd_si512(x), \
+    _mm512_castpd_si512(x)) != 0)
+#define BI_AVX_ALL_P(x) (_mm512_test_epi64_mask(_mm512_castpd_si512(x), \
+    _mm512_castpd_si512(x)) == 0xFF)
+#endif
+#else
+#ifdef ENABLE_SINGLE
+#define BI_AVX_PACKED __m256
+#define BI_AVX_ADD_P _mm256_add_ps
+#define BI_AVX_SUB_P _mm256_sub_ps
+#define BI_AVX_MUL_P _mm256_mul_ps
+#define BI_AVX_DIV_P _mm256_div_ps
+#define BI_AVX_SQRT_P _mm256_sqrt_ps
+#define BI_AVX_MAX_P _mm256_max_ps
+#define BI_AVX_MIN_P _mm256_min_ps
+#define BI_AVX_LOAD_P _mm256_load_ps
+#define BI_AVX_STORE_P _mm256_store_ps
+#define BI_AVX_SET1_P _mm256_set1_ps
+#define BI_AVX_CMP_P _mm256_cmp_ps
+#define BI_AVX_AND_P _mm256_and_ps
+#define BI_AVX_ANDNOT_P _mm256_andnot_ps
+#define BI_AVX_XOR_P _mm256_xor_ps
+#define BI_AVX_ANY_P(x) (_mm256_movemask_ps(x) != 0)
+#define BI_AVX_ALL_P(x) (_mm256_movemask_ps(x) == 0xFF)
+#else
+#define BI_AVX_PACKED __m256d
+#define BI_AVX_ADD_P _mm256_add_pd
+#define BI_AVX_SUB_P _mm256_sub_pd
+#define BI_AVX_MUL_P _mm256_mul_pd
+#define BI_AVX_DIV_P _mm256_div_pd
+#define BI_AVX_SQRT_P _mm256_sqrt_pd
+#define BI_AVX_MAX_P _mm256_max_pd
+#define BI_AVX_MIN_P _mm256_min_pd
+#define BI_AVX_LOAD_P _mm256_load_pd
+#define BI_AVX_STORE_P _mm256_store_pd
+#define BI_AVX_SET1_P _mm256_set1_pd
+#define BI_AVX_CMP_P _mm256_cmp_pd
+#define BI_AVX_AND_P _mm256_and_pd
+#define BI_AVX_ANDNOT_P _mm256_andnot_pd
+#define BI_AVX_XOR_P _mm256_xor_pd
+#define BI_AVX_ANY_P(x) (_mm256_movemask_pd(x) != 0)
+#define BI_AVX_ALL_P(x) (_mm256_movemask_pd(x) == 0xF)
+#endif
+#endif
+#define BI_AVX_CMPEQ_P(x, y) BI_AVX_CMP_P(x, y, _CMP_EQ_OQ)
+#define BI_AVX_CMPNEQ_P(x, y) BI_AVX_CMP_P(x, y, _CMP_NEQ_UQ)
+#define BI_AVX_CMPLT_P(x, y) BI_AVX_CMP_P(x, y, _CMP_LT_OQ)
+#define BI_AVX_CMPLE_P(x, y) BI_AVX_CMP_P(x, y, _CMP_LE_OQ)
+#define BI_AVX_CMPGT_P(x, y) BI_AVX_CMP_P(x, y, _CMP_GT_OQ)
+#define BI_AVX_CMPGE_P(x, y) BI_AVX_CMP_P(x, y, _CMP_GE_OQ)
+
+/**
+ * 256- or 512-bit packed floating point type.
+ */
+namespace bi {
+  union avx_real {
+    real unpacked[BI_AVX_SIZE];
+    BI_AVX_PACKED packed;
+
+    avx_real() {
+      //
+    }
+
+    avx_real(const BI_AVX_PACKED x) : packed(x) {
+      //
+    }
+
+    avx_real(const real a) {
+      packed = BI_AVX_SET1_P(a);
+    }
+
+    avx_real& operator=(const real a) {
+      packed = BI_AVX_SET1_P(a);
+      return *this;
+    }
+
+    real& operator[](const int i) {
+      return unpacked[i];
+    }
+
+    const real& operator[](const int i) const {
+      return unpacked[i];
+    }
+  };
+
+avx_real& operator+=(avx_real& o1, const avx_real& o2);
+avx_real& operator-=(avx_real& o1, const avx_real& o2);
+avx_real& operator*=(avx_real& o1, const avx_real& o2);
+avx_real& operator/=(avx_real& o1, const avx_real& o2);
+avx_real operator+(const avx_real& o1, const avx_real& o2);
+avx_real operator-(const avx_real& o1, const avx_real& o2);
+avx_real operator*(const avx_real& o1, const avx_real& o2);
+avx_real operator/(const avx_real& o1, const avx_real& o2);
+avx_real operator+(const real& o1, const avx_real& o2);
+avx_real operator-(const real& o1, const avx_real& o2);
+avx_real operator*(const real& o1, const avx_real& o2);
+avx_real operator/(const real& o1, const avx_real& o2);
+avx_real operator+(const avx_real& o1, const real& o2);
+avx_real operator-(const avx_real& o1, const real& o2);
+avx_real operator*(const avx_real& o1, const real& o2);
+avx_real operator/(const avx_real& o1, const real& o2);
+avx_real operator==(const avx_real& o1, const avx_real& o2);
+avx_real operator!=(const avx_real& o1, const avx_real& o2);
+avx_real operator<(const avx_real& o1, const avx_real& o2);
+avx_real operator<=(const avx_real& o1, const avx_real& o2);
+avx_real operator>(const avx_real& o1, const avx_real& o2);
+avx_real operator>=(const avx_real& o1, const avx_real& o2);
+const avx_real operator-(const avx_real& o);
+const avx_real operator+(const avx_real& o);
+
+}
+
+BI_FORCE_INLINE inline bi::avx_real& bi::operator+=(bi::avx_real& o1, const bi::avx_real& o2) {
+  o1.packed = BI_AVX_ADD_P(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline bi::avx_real& bi::operator-=(bi::avx_real& o1, const bi::avx_real& o2) {
+  o1.packed = BI_AVX_SUB_P(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline bi::avx_real& bi::operator*=(bi::avx_real& o1, const bi::avx_real& o2) {
+  o1.packed = BI_AVX_MUL_P(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline bi::avx_real& bi::operator/=(bi::avx_real& o1, const bi::avx_real& o2) {
+  o1.packed = BI_AVX_DIV_P(o1.packed, o2.packed);
+  return o1;
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator+(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_ADD_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator-(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_SUB_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator*(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_MUL_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator/(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_DIV_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator+(const real& o1, const bi::avx_real& o2) {
+  return BI_AVX_SET1_P(o1) + o2;
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator-(const real& o1, const bi::avx_real& o2) {
+  return BI_AVX_SET1_P(o1) - o2;
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator*(const real& o1, const bi::avx_real& o2) {
+  return BI_AVX_SET1_P(o1)*o2;
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator/(const real& o1, const bi::avx_real& o2) {
+  return BI_AVX_SET1_P(o1)/o2;
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator+(const bi::avx_real& o1, const real& o2) {
+  return o1 + BI_AVX_SET1_P(o2);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator-(const bi::avx_real& o1, const real& o2) {
+  return o1 - BI_AVX_SET1_P(o2);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator*(const bi::avx_real& o1, const real& o2) {
+  return o1*BI_AVX_SET1_P(o2);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator/(const bi::avx_real& o1, const real& o2) {
+  return o1/BI_AVX_SET1_P(o2);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator==(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPEQ_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator!=(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPNEQ_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator<(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPLT_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator<=(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPLE_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator>(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPGT_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline bi::avx_real bi::operator>=(const bi::avx_real& o1, const bi::avx_real& o2) {
+  return BI_AVX_CMPGE_P(o1.packed, o2.packed);
+}
+
+BI_FORCE_INLINE inline const bi::avx_real bi::operator-(const bi::avx_real& o) {
+  return BI_AVX_XOR_P(BI_AVX_SET1_P(BI_REAL(-0.0)), o.packed);
+}
+
+BI_FORCE_INLINE inline const bi::avx_real bi::operator+(const bi::avx_real& o) {
+  return o;
+}
+
+#endif
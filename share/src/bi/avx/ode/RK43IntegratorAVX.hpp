@@ -0,0 +1,200 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_AVX_ODE_RK43INTEGRATORAVX_HPP
+#define BI_AVX_ODE_RK43INTEGRATORAVX_HPP
+
+namespace bi {
+/**
+ * @copydoc RK43Integrator
+ *
+ * Each lane integrates a different trajectory, with its own time and step
+ * size. A lane that finishes is refilled with the next trajectory from a
+ * queue shared by all threads, so that trajectories requiring many steps do
+ * not hold back those in other lanes. The step size of each trajectory is
+ * kept between calls (see IntegratorState).
+ */
+template<class B, class S, class T1>
+class RK43IntegratorAVX {
+public:
+  /**
+   * @copydoc RK43Integrator::integrate()
+   */
+  static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
+};
+}
+
+#include "../avx_host.hpp"
+#include "../math/function.hpp"
+#include "../math/control.hpp"
+#include "../../host/ode/RK43VisitorHost.hpp"
+#include "../../host/ode/IntegratorConstants.hpp"
+#include "../../host/ode/IntegratorDiagnostics.hpp"
+#include "../../host/ode/IntegratorState.hpp"
+#include "../../state/Pa.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+
+#include "boost/typeof/typeof.hpp"
+
+template<class B, class S, class T1>
+void bi::RK43IntegratorAVX<B,S,T1>::update(const T1 t1, const T1 t2,
+    State<B,ON_HOST>& s) {
+  /* pre-condition */
+  BI_ASSERT(t1 < t2);
+
+  typedef host_vector_reference<avx_real> vector_reference_type;
+  typedef Pa<ON_HOST,B,host,host,avx_host,avx_host> PX;
+  typedef RK43VisitorHost<B,S,S,avx_real,PX,avx_real> Visitor;
+  typedef IntegratorState<B,S> Persist;
+  static const int N = block_size<S>::value;
+  const int P = s.size();
+  int next = 0; // next trajectory in queue
+
+  Persist::init(s);
+  BOOST_AUTO(O, s.getOde());
+
+  #ifdef ENABLE_DIAGNOSTICS
+  IntegratorDiagnostics diagnostics("RK43IntegratorAVX");
+  #endif
+
+  #pragma omp parallel
+  {
+    State<B,ON_HOST> x(BI_AVX_SIZE); // one trajectory in each lane
+    avx_real buf[4*N]; // use of dynamic array faster than heap allocation
+    vector_reference_type r1(buf, N);
+    vector_reference_type r2(buf + N, N);
+    vector_reference_type err(buf + 2*N, N);
+    vector_reference_type old(buf + 3*N, N);
+
+    avx_real t, h, hprop, e, e2, logfacold, logfac11, fac, accept;
+    int q[BI_AVX_SIZE], n[BI_AVX_SIZE];
+    int id, k, active;
+    real hk, logfacoldk;
+    bool empty = false, refill;
+    PX pax;
+    #ifdef ENABLE_DIAGNOSTICS
+    long steps = 0;
+    #endif
+
+    x.getCommon() = s.getCommon();
+    for (k = 0; k < BI_AVX_SIZE; ++k) {
+      q[k] = -1;
+      t[k] = t2;
+      h[k] = BI_REAL(0.0);
+    }
+
+    while (true) {
+      /* retire lanes that have finished, refill from queue */
+      refill = false;
+      active = 0;
+      for (k = 0; k < BI_AVX_SIZE; ++k) {
+        if (q[k] >= 0 && (t[k] >= t2 || n[k] >= h_nsteps)) {
+          row(s.getTraj(), q[k]) = row(x.getTraj(), k);
+          hk = (t[k] >= t2) ? bi::max(h[k], hprop[k]) : h[k];
+          logfacoldk = logfacold[k];
+          Persist::store(row(O, q[k]), hk, logfacoldk);
+          #ifdef ENABLE_DIAGNOSTICS
+          steps += n[k];
+          #endif
+          q[k] = -1;
+        }
+        if (q[k] < 0 && !empty) {
+          #pragma omp atomic capture
+          q[k] = next++;
+
+          if (q[k] < P) {
+            row(x.getTraj(), k) = row(s.getTraj(), q[k]);
+            t[k] = t1;
+            Persist::load(row(O, q[k]), hk, logfacoldk);
+            h[k] = hk;
+            logfacold[k] = logfacoldk;
+            n[k] = 0;
+            refill = true;
+          } else {
+            q[k] = -1;
+            empty = true;
+          }
+        }
+        if (q[k] >= 0) {
+          ++active;
+        } else {
+          /* idle lane, zero step leaves it unchanged */
+          t[k] = t2;
+          h[k] = BI_REAL(0.0);
+        }
+      }
+      if (active == 0) {
+        break;
+      }
+      if (refill) {
+        avx_host_load<B,S>(x, 0, old);
+        r1 = old;
+      }
+
+      /* truncate last step of each lane at end of interval, keeping the
+       * step size proposed before truncation */
+      hprop = h;
+      h = avx_if(t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0), t2 - t, h);
+
+      /* stages */
+      Visitor::stage1(t, h, x, 0, pax, r1.buf(), r2.buf(), err.buf());
+      avx_host_store<B,S>(x, 0, r1);
+
+      Visitor::stage2(t, h, x, 0, pax, r1.buf(), r2.buf(), err.buf());
+      avx_host_store<B,S>(x, 0, r2);
+
+      Visitor::stage3(t, h, x, 0, pax, r1.buf(), r2.buf(), err.buf());
+      avx_host_store<B,S>(x, 0, r1);
+
+      Visitor::stage4(t, h, x, 0, pax, r1.buf(), r2.buf(), err.buf());
+      avx_host_store<B,S>(x, 0, r2);
+
+      Visitor::stage5(t, h, x, 0, pax, r1.buf(), r2.buf(), err.buf());
+      avx_host_store<B,S>(x, 0, r1);
+
+      /* compute error of each lane */
+      e2 = BI_REAL(0.0);
+      for (id = 0; id < N; ++id) {
+        e = err(id)*h/(bi::max(bi::abs(old(id)), bi::abs(r1(id)))*h_rtoler + h_atoler);
+        e2 += e*e;
+      }
+      e2 /= BI_REAL(N);
+
+      /* accept or reject each lane */
+      accept = e2 <= BI_REAL(1.0);
+      t = avx_if(accept, t + h, t);
+      for (id = 0; id < N; ++id) {
+        old(id) = avx_if(accept, r1(id), old(id));
+      }
+      if (!avx_all(accept)) {
+        r1 = old;
+        avx_host_store<B,S>(x, 0, old);
+      }
+
+      /* compute next step size of each lane; packed max and min return the
+       * second argument if either is NaN, so a NaN error shrinks by facl */
+      logfac11 = h_expo*bi::log(e2);
+      fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
+      fac = bi::min(bi::max(fac, h_facl), h_facr); // bound
+      h *= avx_if(accept, fac, bi::max(bi::exp(h_logsafe - logfac11), h_facl));
+      logfacold = avx_if(accept, BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8))), logfacold);
+
+      for (k = 0; k < BI_AVX_SIZE; ++k) {
+        if (q[k] >= 0) {
+          ++n[k];
+        }
+      }
+    }
+
+    #ifdef ENABLE_DIAGNOSTICS
+    diagnostics.record(steps);
+    #endif
+  }
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#include "MmapBuffer.hpp"
+
+#include "../misc/assert.hpp"
+
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+const char bi::MmapBuffer::MAGIC[8] = { 'L', 'I', 'B', 'B', 'I', 'M', 'M',
+    '\0' };
+
+bi::MmapBuffer::MmapBuffer(const std::string& file, const FileMode mode) :
+    file(file), mode(mode), data(NULL), mapped(0), reserved(0) {
+  switch (mode) {
+  case WRITE:
+    fd = open(file.c_str(), O_RDWR);
+    break;
+  case NEW:
+    fd = open(file.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    break;
+  case REPLACE:
+    fd = open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    break;
+  default:
+    fd = open(file.c_str(), O_RDONLY);
+  }
+  BI_ERROR_MSG(fd >= 0, "Could not open " << file);
+
+  reserve(sizeof(Header));
+  remap();
+  if (isNew()) {
+    Header& h = header();
+    std::copy(MAGIC, MAGIC + sizeof(MAGIC), h.magic);
+    h.version = VERSION;
+    h.realSize = sizeof(real);
+  } else {
+    const Header& h = header();
+    BI_ERROR_MSG(std::equal(MAGIC, MAGIC + sizeof(MAGIC), h.magic),
+        "File " << file << " is not a memory-mapped LibBi file");
+    BI_ERROR_MSG(h.version == VERSION,
+        "File " << file << " has layout version " << h.version << ", should be " << VERSION);
+    BI_ERROR_MSG(h.realSize == (int32_t)sizeof(real),
+        "File " << file << " has " << h.realSize << " byte reals, should have " << sizeof(real));
+  }
+}
+
+bi::MmapBuffer::~MmapBuffer() {
+  if (data != NULL) {
+    munmap(data, mapped);
+  }
+  close(fd);
+}
+
+void bi::MmapBuffer::clear() {
+  //
+}
+
+void bi::MmapBuffer::flush() {
+  if (mode != READ_ONLY) {
+    msync(data, mapped, MS_ASYNC);
+  }
+}
+
+size_t bi::MmapBuffer::reserve(const size_t bytes) {
+  size_t offset = reserved;
+  reserved += ((bytes + ALIGN - 1)/ALIGN)*ALIGN;
+  return offset;
+}
+
+void bi::MmapBuffer::remap() {
+  struct stat st;
+  int prot;
+
+  if (isNew()) {
+    BI_ERROR_MSG(ftruncate(fd, reserved) == 0,
+        "Could not extend " << file << " to " << reserved << " bytes");
+  } else {
+    BI_ERROR_MSG(fstat(fd, &st) == 0 && st.st_size >= (off_t)reserved,
+        "File " << file << " is too short, should be at least " << reserved << " bytes");
+  }
+  if (data != NULL) {
+    munmap(data, mapped);
+  }
+  prot = (mode == READ_ONLY) ? PROT_READ : PROT_READ | PROT_WRITE;
+  data = static_cast<char*>(mmap(NULL, reserved, prot, MAP_SHARED, fd, 0));
+  BI_ERROR_MSG(data != MAP_FAILED, "Could not map " << file);
+  mapped = reserved;
+}
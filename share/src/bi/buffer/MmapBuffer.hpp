@@ -0,0 +1,239 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_BUFFER_MMAPBUFFER_HPP
+#define BI_BUFFER_MMAPBUFFER_HPP
+
+#include "../traits/var_traits.hpp"
+#include "../math/scalar.hpp"
+
+#include <string>
+#include <stdint.h>
+
+namespace bi {
+/**
+ * Memory-mapped output file of fixed layout.
+ *
+ * @ingroup io_buffer
+ *
+ * The file begins with a header page, followed by sections, each aligned
+ * to a page, whose layout is computed by derived classes from the header
+ * alone. Values are stored in the native byte order and precision of the
+ * build, which the header records and which a file must match to be
+ * opened. Writes are copies into mapped pages, left to the operating system
+ * to write back, and reads may be served by references into them.
+ *
+ * Only outputs are supported. The @c filter command writes them with
+ * <tt>--output-format mmap</tt>, and @c convert translates them to and
+ * from NetCDF. Input, initialisation and observation files are still read
+ * through SparseInputNetCDFBuffer.
+ */
+class MmapBuffer {
+public:
+  /**
+   * File open flags.
+   */
+  enum FileMode {
+    /**
+     * Open file read-only.
+     */
+    READ_ONLY,
+
+    /**
+     * Open file for reading and writing,
+     */
+    WRITE,
+
+    /**
+     * Open file for reading and writing, replacing any existing file of the
+     * same name.
+     */
+    REPLACE,
+
+    /**
+     * Open file for reading and writing, fails if any existing file of the
+     * same name
+     */
+    NEW
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param file File name.
+   * @param mode File open mode.
+   */
+  MmapBuffer(const std::string& file, const FileMode mode = READ_ONLY);
+
+  /**
+   * Destructor.
+   */
+  ~MmapBuffer();
+
+  /**
+   * Does nothing but maintain interface with caches.
+   */
+  void clear();
+
+  /**
+   * Schedule write back of all mapped pages.
+   */
+  void flush();
+
+protected:
+  /**
+   * File header.
+   */
+  struct Header {
+    /**
+     * Magic string, #MAGIC.
+     */
+    char magic[8];
+
+    /**
+     * Version of layout, #VERSION.
+     */
+    int32_t version;
+
+    /**
+     * Size of floating point values, in bytes.
+     */
+    int32_t realSize;
+
+    /**
+     * Schema name, as for the @c libbi_schema attribute of NetCDF files.
+     */
+    char name[32];
+
+    /**
+     * Schema mode of derived class.
+     */
+    int32_t schema;
+
+    /**
+     * Number of samples.
+     */
+    int64_t P;
+
+    /**
+     * Number of times.
+     */
+    int64_t T;
+
+    /**
+     * Net sizes of variable types, used to validate file against model.
+     */
+    int64_t sizes[NUM_VAR_TYPES];
+  };
+
+  /**
+   * Is the file being created?
+   */
+  bool isNew() const;
+
+  /**
+   * Reserve section of file.
+   *
+   * @param bytes Size of section, in bytes.
+   *
+   * @return Offset of section, in bytes.
+   */
+  size_t reserve(const size_t bytes);
+
+  /**
+   * Map all sections reserved so far, extending the file if created, and
+   * checking its size otherwise.
+   */
+  void remap();
+
+  /**
+   * Header, once mapped.
+   */
+  Header& header() const;
+
+  /**
+   * Pointer to section.
+   *
+   * @tparam T Value type.
+   *
+   * @param offset Offset of section, in bytes.
+   */
+  template<class T>
+  T* section(const size_t offset) const;
+
+  /**
+   * File name.
+   */
+  std::string file;
+
+  /**
+   * File open mode.
+   */
+  FileMode mode;
+
+  /**
+   * File descriptor.
+   */
+  int fd;
+
+  /**
+   * Mapped pages.
+   */
+  char* data;
+
+  /**
+   * Size of mapped pages, in bytes.
+   */
+  size_t mapped;
+
+  /**
+   * Size of sections reserved, in bytes.
+   */
+  size_t reserved;
+
+  /**
+   * Alignment of sections, in bytes.
+   */
+  static const size_t ALIGN = 4096;
+
+  /**
+   * Magic string.
+   */
+  static const char MAGIC[8];
+
+  /**
+   * Version of layout.
+   */
+  static const int32_t VERSION = 1;
+
+private:
+  /**
+   * Copy constructor, not implemented, as owns mapping.
+   */
+  MmapBuffer(const MmapBuffer& o);
+
+  /**
+   * Assignment operator, not implemented, as owns mapping.
+   */
+  MmapBuffer& operator=(const MmapBuffer& o);
+};
+}
+
+inline bool bi::MmapBuffer::isNew() const {
+  return mode == NEW || mode == REPLACE;
+}
+
+inline bi::MmapBuffer::Header& bi::MmapBuffer::header() const {
+  return *section<Header>(0);
+}
+
+template<class T>
+inline T* bi::MmapBuffer::section(const size_t offset) const {
+  return reinterpret_cast<T*>(data + offset);
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#include "MmapParticleFilterBuffer.hpp"
+
+#include <cstring>
+
+bi::MmapParticleFilterBuffer::MmapParticleFilterBuffer(const Model& m,
+    const std::string& file, const FileMode mode) :
+    MmapSimulatorBuffer(m, file, mode), aOffset(0), lwOffset(0),
+    llOffset(0) {
+  map();
+}
+
+bi::MmapParticleFilterBuffer::MmapParticleFilterBuffer(const Model& m,
+    const size_t P, const size_t T, const std::string& file,
+    const FileMode mode, const SchemaMode schema) :
+    MmapSimulatorBuffer(m, P, T, file, mode, schema), aOffset(0),
+    lwOffset(0), llOffset(0) {
+  if (isNew()) {
+    create();
+  } else {
+    map();
+  }
+}
+
+void bi::MmapParticleFilterBuffer::create() {
+  std::strncpy(header().name, "ParticleFilter", sizeof(header().name));
+  layout();
+  remap();
+}
+
+void bi::MmapParticleFilterBuffer::map() {
+  BI_ERROR_MSG(std::strncmp(header().name, "ParticleFilter",
+      sizeof(header().name)) == 0,
+      "File " << file << " has schema " << header().name << ", should be ParticleFilter");
+  layout();
+  remap();
+}
+
+void bi::MmapParticleFilterBuffer::layout() {
+  const size_t P = getNumSamples();
+  const size_t T = getNumTimes();
+
+  aOffset = reserve(T*P*sizeof(int));
+  lwOffset = reserve(T*P*sizeof(real));
+  llOffset = reserve(sizeof(real));
+}
+
+void bi::MmapParticleFilterBuffer::readLL(real& ll) {
+  ll = *section<real>(llOffset);
+}
+
+void bi::MmapParticleFilterBuffer::writeLL(const real ll) {
+  *section<real>(llOffset) = ll;
+}
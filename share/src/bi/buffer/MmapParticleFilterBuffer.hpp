@@ -0,0 +1,192 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_BUFFER_MMAPPARTICLEFILTERBUFFER_HPP
+#define BI_BUFFER_MMAPPARTICLEFILTERBUFFER_HPP
+
+#include "MmapSimulatorBuffer.hpp"
+
+namespace bi {
+/**
+ * Memory-mapped buffer for storing, reading and writing results of a
+ * particle filter, with the same interface as ParticleFilterNetCDFBuffer.
+ *
+ * @ingroup io_buffer
+ *
+ * Extends the layout of MmapSimulatorBuffer with sections for log-weights
+ * and ancestors, each a @c P by @c T matrix, and for the marginal
+ * log-likelihood estimate.
+ */
+class MmapParticleFilterBuffer: public MmapSimulatorBuffer {
+public:
+  using MmapSimulatorBuffer::writeState;
+
+  /**
+   * Constructor.
+   *
+   * @param m Model.
+   * @param file File name.
+   * @param mode File open mode.
+   */
+  MmapParticleFilterBuffer(const Model& m, const std::string& file,
+      const FileMode mode = READ_ONLY);
+
+  /**
+   * Constructor.
+   *
+   * @param m Model.
+   * @param P Number of samples in file.
+   * @param T Number of times in file.
+   * @param file File name.
+   * @param mode File open mode.
+   * @param schema Schema mode.
+   */
+  MmapParticleFilterBuffer(const Model& m, const size_t P, const size_t T,
+      const std::string& file, const FileMode mode = READ_ONLY,
+      const SchemaMode schema = DEFAULT);
+
+  /**
+   * Get particle log-weights.
+   *
+   * @param k Time index.
+   *
+   * @return Reference into file.
+   */
+  host_vector_reference<real> getLogWeights(const size_t k) const;
+
+  /**
+   * Get particle ancestors.
+   *
+   * @param k Time index.
+   *
+   * @return Reference into file.
+   */
+  host_vector_reference<int> getAncestors(const size_t k) const;
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::readLogWeights()
+   */
+  template<class V1>
+  void readLogWeights(const size_t k, V1 lws);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::writeLogWeights()
+   */
+  template<class V1>
+  void writeLogWeights(const size_t k, const V1 lws);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::readAncestors()
+   */
+  template<class V1>
+  void readAncestors(const size_t k, V1 a);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::writeAncestors()
+   */
+  template<class V1>
+  void writeAncestors(const size_t k, const V1 a);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::writeState()
+   */
+  template<class M1, class V1>
+  void writeState(const size_t k, const M1 X, const V1 as);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::readLL()
+   */
+  void readLL(real& ll);
+
+  /**
+   * @copydoc ParticleFilterNetCDFBuffer::writeLL()
+   */
+  void writeLL(const real ll);
+
+protected:
+  /**
+   * Set up structure of file.
+   */
+  void create();
+
+  /**
+   * Map structure of existing file.
+   */
+  void map();
+
+  /**
+   * Reserve sections of file.
+   */
+  void layout();
+
+  /**
+   * Offset of ancestors section.
+   */
+  size_t aOffset;
+
+  /**
+   * Offset of log-weights section.
+   */
+  size_t lwOffset;
+
+  /**
+   * Offset of marginal log-likelihood estimate section.
+   */
+  size_t llOffset;
+};
+}
+
+inline bi::host_vector_reference<real> bi::MmapParticleFilterBuffer::getLogWeights(
+    const size_t k) const {
+  /* pre-condition */
+  BI_ASSERT(k < getNumTimes());
+
+  return host_vector_reference<real>(
+      section<real>(lwOffset) + k*getNumSamples(), getNumSamples());
+}
+
+inline bi::host_vector_reference<int> bi::MmapParticleFilterBuffer::getAncestors(
+    const size_t k) const {
+  /* pre-condition */
+  BI_ASSERT(k < getNumTimes());
+
+  return host_vector_reference<int>(
+      section<int>(aOffset) + k*getNumSamples(), getNumSamples());
+}
+
+template<class V1>
+void bi::MmapParticleFilterBuffer::readLogWeights(const size_t k, V1 lws) {
+  lws = subrange(getLogWeights(k), 0, lws.size());
+}
+
+template<class V1>
+void bi::MmapParticleFilterBuffer::writeLogWeights(const size_t k,
+    const V1 lws) {
+  subrange(getLogWeights(k), 0, lws.size()) = lws;
+  synchronize(V1::on_device);
+}
+
+template<class V1>
+void bi::MmapParticleFilterBuffer::readAncestors(const size_t k, V1 as) {
+  as = subrange(getAncestors(k), 0, as.size());
+}
+
+template<class V1>
+void bi::MmapParticleFilterBuffer::writeAncestors(const size_t k,
+    const V1 as) {
+  subrange(getAncestors(k), 0, as.size()) = as;
+  synchronize(V1::on_device);
+}
+
+template<class M1, class V1>
+void bi::MmapParticleFilterBuffer::writeState(const size_t k, const M1 X,
+    const V1 as) {
+  MmapSimulatorBuffer::writeState(k, X);
+  writeAncestors(k, as);
+}
+
+#endif
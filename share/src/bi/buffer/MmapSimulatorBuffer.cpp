@@ -0,0 +1,93 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#include "MmapSimulatorBuffer.hpp"
+
+#include <cstring>
+
+bi::MmapSimulatorBuffer::MmapSimulatorBuffer(const Model& m,
+    const std::string& file, const FileMode mode) :
+    MmapBuffer(file, mode), m(m), tOffset(0), offsets(NUM_VAR_TYPES, 0) {
+  BI_ERROR_MSG(!isNew(),
+      "Number of samples and times required to create " << file);
+  map();
+}
+
+bi::MmapSimulatorBuffer::MmapSimulatorBuffer(const Model& m,
+    const size_t P, const size_t T, const std::string& file,
+    const FileMode mode, const SchemaMode schema) :
+    MmapBuffer(file, mode), m(m), tOffset(0), offsets(NUM_VAR_TYPES, 0) {
+  if (isNew()) {
+    create(P, T, schema);
+  } else {
+    map(P, T);
+  }
+}
+
+void bi::MmapSimulatorBuffer::create(const size_t P, const size_t T,
+    const SchemaMode schema) {
+  BI_ERROR_MSG(P > 0 && T > 0,
+      "Number of samples and times must be positive to create " << file);
+
+  Header& h = header();
+  int i;
+
+  std::strncpy(h.name, "Simulator", sizeof(h.name));
+  h.schema = schema;
+  h.P = P;
+  h.T = T;
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    h.sizes[i] = m.getNetSize(static_cast<VarType>(i));
+  }
+  layout();
+  remap();
+}
+
+void bi::MmapSimulatorBuffer::map(const size_t P, const size_t T) {
+  const Header& h = header();
+  int i;
+
+  BI_ERROR_MSG(h.schema >= DEFAULT && h.schema <= PARAM_ONLY,
+      "Unknown schema " << h.schema << " in file " << file);
+  BI_ERROR_MSG(P == 0 || h.P == (int64_t)P,
+      "File has " << h.P << " samples, should have " << P << ", in file " << file);
+  BI_ERROR_MSG(T == 0 || h.T == (int64_t)T,
+      "File has " << h.T << " times, should have " << T << ", in file " << file);
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    BI_ERROR_MSG(h.sizes[i] == m.getNetSize(static_cast<VarType>(i)),
+        "Variables of type " << i << " have net size " << h.sizes[i] << ", should have " << m.getNetSize(static_cast<VarType>(i)) << ", in file " << file);
+  }
+  layout();
+  remap();
+}
+
+void bi::MmapSimulatorBuffer::layout() {
+  const size_t P = getNumSamples();
+  const size_t T = getNumTimes();
+  const size_t Q = (getSchema() == DEFAULT) ? 1 : P;
+
+  tOffset = reserve(T*sizeof(real));
+  offsets[P_VAR] = reserve(Q*m.getNetSize(P_VAR)*sizeof(real));
+  if (getSchema() != PARAM_ONLY) {
+    offsets[R_VAR] = reserve(T*P*m.getNetSize(R_VAR)*sizeof(real));
+    offsets[D_VAR] = reserve(T*P*m.getNetSize(D_VAR)*sizeof(real));
+  }
+}
+
+void bi::MmapSimulatorBuffer::readTime(const size_t k, real& t) const {
+  /* pre-condition */
+  BI_ASSERT(k < getNumTimes());
+
+  t = section<real>(tOffset)[k];
+}
+
+void bi::MmapSimulatorBuffer::writeTime(const size_t k, const real& t) {
+  /* pre-condition */
+  BI_ASSERT(k < getNumTimes());
+
+  section<real>(tOffset)[k] = t;
+}
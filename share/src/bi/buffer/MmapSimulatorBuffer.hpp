@@ -0,0 +1,380 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_BUFFER_MMAPSIMULATORBUFFER_HPP
+#define BI_BUFFER_MMAPSIMULATORBUFFER_HPP
+
+#include "MmapBuffer.hpp"
+#include "../model/Model.hpp"
+#include "../math/matrix.hpp"
+#include "../math/vector.hpp"
+#include "../cuda/cuda.hpp"
+#include "../misc/assert.hpp"
+
+#include <vector>
+
+namespace bi {
+/**
+ * Memory-mapped buffer for storing, reading and writing results of
+ * Simulator, with the same interface as SimulatorNetCDFBuffer.
+ *
+ * @ingroup io_buffer
+ *
+ * Following the header, the file holds sections for:
+ *
+ * @li times, a vector of length @c T,
+ * @li parameters, a matrix of @c Q rows, and
+ * @li noise and state variables, each @c T matrices of @c P rows,
+ *
+ * where @c P is the number of samples, @c T the number of times, and @c Q is
+ * one, or @c P for the multi and parameters-only schemas, the latter
+ * without sections for noise and state variables. Each matrix is stored
+ * column major, with rows indexing samples and columns the variables of the
+ * type in turn, as in State, so that a read or write of all samples is one
+ * copy, and getState() can return a reference into the file for reads with
+ * no copy at all.
+ *
+ * Unlike NetCDF files, the numbers of samples and times are fixed on
+ * creation, and the flexi schema is not supported.
+ */
+class MmapSimulatorBuffer: public MmapBuffer {
+public:
+  /**
+   * Schema flags.
+   */
+  enum SchemaMode {
+    /**
+     * Default schema.
+     */
+    DEFAULT,
+
+    /**
+     * Have multiple parameter samples.
+     */
+    MULTI,
+
+    /**
+     * Multiple parameter samples, but parameters only.
+     */
+    PARAM_ONLY
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param m Model.
+   * @param file File name.
+   * @param mode File open mode.
+   */
+  MmapSimulatorBuffer(const Model& m, const std::string& file,
+      const FileMode mode = READ_ONLY);
+
+  /**
+   * Constructor.
+   *
+   * @param m Model.
+   * @param P Number of samples to hold in file.
+   * @param T Number of times to hold in file.
+   * @param file File name.
+   * @param mode File open mode.
+   * @param schema Schema mode.
+   */
+  MmapSimulatorBuffer(const Model& m, const size_t P, const size_t T,
+      const std::string& file, const FileMode mode = READ_ONLY,
+      const SchemaMode schema = DEFAULT);
+
+  /**
+   * Number of samples held in file.
+   */
+  size_t getNumSamples() const;
+
+  /**
+   * Number of times held in file.
+   */
+  size_t getNumTimes() const;
+
+  /**
+   * Schema mode.
+   */
+  SchemaMode getSchema() const;
+
+  /**
+   * Get all times.
+   *
+   * @return Reference into file.
+   */
+  host_vector_reference<real> getTimes() const;
+
+  /**
+   * Get state of all samples.
+   *
+   * @param type Variable type.
+   * @param k Time index. Ignored for parameters.
+   *
+   * @return Reference into file. Rows index samples, columns variables.
+   */
+  host_matrix_reference<real> getState(const VarType type,
+      const size_t k) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readTime()
+   */
+  void readTime(const size_t k, real& t) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeTime()
+   */
+  void writeTime(const size_t k, const real& t);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readTimes()
+   */
+  template<class V1>
+  void readTimes(const size_t k, V1 ts) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeTimes()
+   */
+  template<class V1>
+  void writeTimes(const size_t k, const V1 ts);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readParameters(M1)
+   */
+  template<class M1>
+  void readParameters(M1 X) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeParameters(const M1)
+   */
+  template<class M1>
+  void writeParameters(const M1 X);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readParameters(const size_t, M1)
+   */
+  template<class M1>
+  void readParameters(const size_t p, M1 X) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeParameters(const size_t, const M1)
+   */
+  template<class M1>
+  void writeParameters(const size_t p, const M1 X);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readState(const size_t, M1)
+   */
+  template<class M1>
+  void readState(const size_t k, M1 X) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeState(const size_t, const M1)
+   */
+  template<class M1>
+  void writeState(const size_t k, const M1 X);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readState(const size_t, const size_t, M1)
+   */
+  template<class M1>
+  void readState(const size_t k, const size_t p, M1 X) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeState(const size_t, const size_t, const M1)
+   */
+  template<class M1>
+  void writeState(const size_t k, const size_t p, const M1 X);
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::readState(const VarType, const size_t, const size_t, M1)
+   */
+  template<class M1>
+  void readState(const VarType type, const size_t k, const size_t p,
+      M1 X) const;
+
+  /**
+   * @copydoc SimulatorNetCDFBuffer::writeState(const VarType, const size_t, const size_t, const M1)
+   */
+  template<class M1>
+  void writeState(const VarType type, const size_t k, const size_t p,
+      const M1 X);
+
+protected:
+  /**
+   * Set up structure of file.
+   *
+   * @param P Number of samples.
+   * @param T Number of times.
+   * @param schema Schema mode.
+   */
+  void create(const size_t P, const size_t T, const SchemaMode schema);
+
+  /**
+   * Map structure of existing file.
+   *
+   * @param P Number of samples. Used to validate file, ignored if zero.
+   * @param T Number of times. Used to validate file, ignored if zero.
+   */
+  void map(const size_t P = 0, const size_t T = 0);
+
+  /**
+   * Reserve sections of file, according to header.
+   */
+  void layout();
+
+  /**
+   * Model.
+   */
+  const Model& m;
+
+  /**
+   * Offset of times section.
+   */
+  size_t tOffset;
+
+  /**
+   * Offsets of variable type sections, indexed by type, zero where none.
+   */
+  std::vector<size_t> offsets;
+};
+}
+
+#include "../math/view.hpp"
+
+inline size_t bi::MmapSimulatorBuffer::getNumSamples() const {
+  return header().P;
+}
+
+inline size_t bi::MmapSimulatorBuffer::getNumTimes() const {
+  return header().T;
+}
+
+inline bi::MmapSimulatorBuffer::SchemaMode bi::MmapSimulatorBuffer::getSchema() const {
+  return static_cast<SchemaMode>(header().schema);
+}
+
+inline bi::host_vector_reference<real> bi::MmapSimulatorBuffer::getTimes() const {
+  return host_vector_reference<real>(section<real>(tOffset), getNumTimes());
+}
+
+inline bi::host_matrix_reference<real> bi::MmapSimulatorBuffer::getState(
+    const VarType type, const size_t k) const {
+  /* pre-condition */
+  BI_ASSERT(offsets[type] > 0);
+
+  const size_t size = m.getNetSize(type);
+  size_t rows;
+  if (type == P_VAR) {
+    rows = (getSchema() == DEFAULT) ? 1 : getNumSamples();
+    return host_matrix_reference<real>(section<real>(offsets[type]), rows,
+        size);
+  } else {
+    /* pre-condition */
+    BI_ASSERT(k < getNumTimes());
+
+    rows = getNumSamples();
+    return host_matrix_reference<real>(
+        section<real>(offsets[type]) + k*rows*size, rows, size);
+  }
+}
+
+template<class V1>
+void bi::MmapSimulatorBuffer::readTimes(const size_t k, V1 ts) const {
+  ts = subrange(getTimes(), k, ts.size());
+}
+
+template<class V1>
+void bi::MmapSimulatorBuffer::writeTimes(const size_t k, const V1 ts) {
+  subrange(getTimes(), k, ts.size()) = ts;
+  synchronize(V1::on_device);
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::readParameters(M1 X) const {
+  readState(P_VAR, 0, 0, X);
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::writeParameters(M1 X) {
+  writeState(P_VAR, 0, 0, X);
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::readParameters(const size_t p, M1 X) const {
+  readState(P_VAR, 0, p, X);
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::writeParameters(const size_t p, M1 X) {
+  writeState(P_VAR, 0, p, X);
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::readState(const size_t k, M1 X) const {
+  readState(R_VAR, k, 0, columns(X, 0, m.getNetSize(R_VAR)));
+  readState(D_VAR, k, 0,
+      columns(X, m.getNetSize(R_VAR), m.getNetSize(D_VAR)));
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::writeState(const size_t k, const M1 X) {
+  writeState(R_VAR, k, 0, columns(X, 0, m.getNetSize(R_VAR)));
+  writeState(D_VAR, k, 0,
+      columns(X, m.getNetSize(R_VAR), m.getNetSize(D_VAR)));
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::readState(const size_t k, const size_t p,
+    M1 X) const {
+  readState(R_VAR, k, p, columns(X, 0, m.getNetSize(R_VAR)));
+  readState(D_VAR, k, p,
+      columns(X, m.getNetSize(R_VAR), m.getNetSize(D_VAR)));
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::writeState(const size_t k, const size_t p,
+    const M1 X) {
+  writeState(R_VAR, k, p, columns(X, 0, m.getNetSize(R_VAR)));
+  writeState(D_VAR, k, p,
+      columns(X, m.getNetSize(R_VAR), m.getNetSize(D_VAR)));
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::readState(const VarType type, const size_t k,
+    const size_t p, M1 X) const {
+  host_matrix_reference<real> Y(rows(getState(type, k), p, X.size1()));
+  Var* var;
+  int id;
+
+  for (id = 0; id < m.getNumVars(type); ++id) {
+    var = m.getVar(type, id);
+    if (var->hasInput()) {
+      columns(X, var->getStart(), var->getSize()) = columns(Y,
+          var->getStart(), var->getSize());
+    }
+  }
+}
+
+template<class M1>
+void bi::MmapSimulatorBuffer::writeState(const VarType type, const size_t k,
+    const size_t p, const M1 X) {
+  host_matrix_reference<real> Y(rows(getState(type, k), p, X.size1()));
+  Var* var;
+  int id;
+
+  for (id = 0; id < m.getNumVars(type); ++id) {
+    var = m.getVar(type, id);
+    if (var->hasOutput()) {
+      columns(Y, var->getStart(), var->getSize()) = columns(X,
+          var->getStart(), var->getSize());
+    }
+  }
+  synchronize(M1::on_device);
+}
+
+#endif
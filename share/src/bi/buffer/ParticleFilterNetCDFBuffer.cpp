@@ -45,6 +45,8 @@ void bi::ParticleFilterNetCDFBuffer::create() {
     aVar = nc_def_var(ncid, "ancestor", NC_INT, nrDim, npDim);
     lwVar = nc_def_var(ncid, "logweight", NC_REAL, nrDim, npDim);
   }
+  chunk(aVar);
+  chunk(lwVar);
   llVar = nc_def_var(ncid, "LL", NC_REAL);
 
   nc_enddef(ncid);
@@ -94,6 +96,10 @@ void bi::ParticleFilterNetCDFBuffer::map() {
       "Variable LL has " << dimids.size() << " dimensions, should have 0, in file " << file);
 }
 
+void bi::ParticleFilterNetCDFBuffer::readLL(real& ll) {
+  nc_get_var(ncid, llVar, &ll);
+}
+
 void bi::ParticleFilterNetCDFBuffer::writeLL(const real ll) {
   nc_put_var(ncid, llVar, &ll);
 }
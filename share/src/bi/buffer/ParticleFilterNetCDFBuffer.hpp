@@ -100,6 +100,13 @@ public:
   template<class M1, class V1>
   void writeState(const size_t k, const M1 X, const V1 as);
 
+  /**
+   * Read marginal log-likelihood estimate.
+   *
+   * @param[out] ll Marginal log-likelihood estimate.
+   */
+  void readLL(real& ll);
+
   /**
    * Write marginal log-likelihood estimate.
    *
@@ -35,6 +35,8 @@ void bi::ParticleMCMCNetCDFBuffer::create() {
 
   llVar = nc_def_var(ncid, "loglikelihood", NC_REAL, npDim);
   lpVar = nc_def_var(ncid, "logprior", NC_REAL, npDim);
+  chunk(llVar);
+  chunk(lpVar);
 
   nc_enddef(ncid);
 }
@@ -37,6 +37,8 @@ void bi::SMC2NetCDFBuffer::create() {
 
   lwVar = nc_def_var(ncid, "logweight", NC_REAL, npDim);
   leVar = nc_def_var(ncid, "logevidence", NC_REAL, nrDim);
+  chunk(lwVar);
+  chunk(leVar);
 
   nc_enddef(ncid);
 }
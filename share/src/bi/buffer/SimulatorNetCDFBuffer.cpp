@@ -8,12 +8,44 @@
 #include "SimulatorNetCDFBuffer.hpp"
 
 #include "../math/view.hpp"
+#include "../math/function.hpp"
+
+bi::SimulatorNetCDFBuffer::ChunkMode bi::SimulatorNetCDFBuffer::chunking =
+    DEFAULT_CHUNKS;
+int bi::SimulatorNetCDFBuffer::deflate = 0;
+bool bi::SimulatorNetCDFBuffer::shuffle = true;
+
+void bi::SimulatorNetCDFBuffer::setChunking(const ChunkMode mode,
+    const int deflate, const bool shuffle) {
+  /* pre-condition */
+  BI_ASSERT(deflate >= 0 && deflate <= 9);
+
+  SimulatorNetCDFBuffer::chunking = mode;
+  SimulatorNetCDFBuffer::deflate = deflate;
+  SimulatorNetCDFBuffer::shuffle = shuffle;
+}
+
+bi::SimulatorNetCDFBuffer::ChunkMode bi::SimulatorNetCDFBuffer::chunkMode(
+    const std::string& name) {
+  if (name.compare("time") == 0) {
+    return TIME_CHUNKS;
+  } else if (name.compare("trajectory") == 0) {
+    return TRAJECTORY_CHUNKS;
+  } else if (name.compare("balanced") == 0) {
+    return BALANCED_CHUNKS;
+  } else {
+    BI_ERROR_MSG(name.compare("default") == 0,
+        "Unknown chunking " << name << ", should be default, time, trajectory or balanced");
+    return DEFAULT_CHUNKS;
+  }
+}
 
 bi::SimulatorNetCDFBuffer::SimulatorNetCDFBuffer(const Model& m,
     const std::string& file, const FileMode mode, const SchemaMode schema) :
     NetCDFBuffer(file, mode), m(m), schema(schema), nsDim(-1), nrDim(-1), npDim(
         -1), nrpDim(-1), tVar(-1), startVar(-1), lenVar(-1), vars(
-        NUM_VAR_TYPES) {
+        NUM_VAR_TYPES), plans(NUM_VAR_TYPES), batches(NUM_VAR_TYPES),
+        flushInterval(1) {
   if (mode == NEW || mode == REPLACE) {
     create();
   } else {
@@ -26,7 +58,8 @@ bi::SimulatorNetCDFBuffer::SimulatorNetCDFBuffer(const Model& m,
     const FileMode mode, const SchemaMode schema) :
     NetCDFBuffer(file, mode), m(m), schema(schema), nsDim(-1), nrDim(-1), npDim(
         -1), nrpDim(-1), tVar(-1), startVar(-1), lenVar(-1), vars(
-        NUM_VAR_TYPES) {
+        NUM_VAR_TYPES), plans(NUM_VAR_TYPES), batches(NUM_VAR_TYPES),
+        flushInterval(1) {
   if (mode == NEW || mode == REPLACE) {
     create(P, T);
   } else {
@@ -34,6 +67,25 @@ bi::SimulatorNetCDFBuffer::SimulatorNetCDFBuffer(const Model& m,
   }
 }
 
+bi::SimulatorNetCDFBuffer::~SimulatorNetCDFBuffer() {
+  flush();
+}
+
+void bi::SimulatorNetCDFBuffer::setFlushInterval(const int K) {
+  /* pre-condition */
+  BI_ASSERT(K > 0);
+
+  flush();
+  flushInterval = K;
+}
+
+void bi::SimulatorNetCDFBuffer::flush() {
+  int i;
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    flush(static_cast<VarType>(i));
+  }
+}
+
 void bi::SimulatorNetCDFBuffer::create(const size_t P, const size_t T) {
   int id, i;
   VarType type;
@@ -95,6 +147,7 @@ void bi::SimulatorNetCDFBuffer::create(const size_t P, const size_t T) {
   }
 
   nc_enddef(ncid);
+  plan();
 }
 
 void bi::SimulatorNetCDFBuffer::map(const size_t P, const size_t T) {
@@ -163,6 +216,7 @@ void bi::SimulatorNetCDFBuffer::map(const size_t P, const size_t T) {
       }
     }
   }
+  plan();
 }
 
 int bi::SimulatorNetCDFBuffer::createVar(Var* var) {
@@ -199,7 +253,10 @@ int bi::SimulatorNetCDFBuffer::createVar(Var* var) {
     }
     break;
   }
-  return nc_def_var(ncid, var->getOutputName(), NC_REAL, dims);
+  int varid = nc_def_var(ncid, var->getOutputName(), NC_REAL, dims);
+  chunk(varid);
+
+  return varid;
 }
 
 int bi::SimulatorNetCDFBuffer::mapVar(Var* var) {
@@ -261,6 +318,160 @@ int bi::SimulatorNetCDFBuffer::mapDim(Dim* dim) {
   return dimid;
 }
 
+void bi::SimulatorNetCDFBuffer::chunk(const int varid) {
+  std::vector<int> dimids = nc_inq_vardimid(ncid, varid);
+  std::vector<size_t> chunks(dimids.size());
+  size_t len, T = 0, P = 0, n, nt, np, bytes = sizeof(real);
+  int i, nrIndex = -1, npIndex = -1;
+
+  if (chunking != DEFAULT_CHUNKS && dimids.size() > 0) {
+    /* model dimensions are chunked whole, lengths of time and sample
+     * dimensions are zero if unlimited */
+    for (i = 0; i < static_cast<int>(dimids.size()); ++i) {
+      len = nc_inq_dimlen(ncid, dimids[i]);
+      if (dimids[i] == nrDim) {
+        nrIndex = i;
+        T = len;
+      } else if (dimids[i] == npDim || dimids[i] == nrpDim) {
+        npIndex = i;
+        P = len;
+      } else {
+        chunks[i] = len;
+        bytes *= len;
+      }
+    }
+
+    /* number of times times samples in chunk */
+    n = bi::max(CHUNK_BYTES/bytes, static_cast<size_t>(1));
+    switch (chunking) {
+    case TIME_CHUNKS:
+      nt = 1;
+      break;
+    case TRAJECTORY_CHUNKS:
+      nt = n;
+      break;
+    default:
+      nt = static_cast<size_t>(bi::sqrt(static_cast<double>(n)));
+    }
+    if (npIndex < 0) {
+      nt = n;
+    } else if (nrIndex < 0) {
+      nt = 1;
+    }
+    if (T > 0) {
+      nt = bi::min(nt, T);
+    }
+    nt = bi::max(nt, static_cast<size_t>(1));
+    np = bi::max(n/nt, static_cast<size_t>(1));
+    if (P > 0) {
+      np = bi::min(np, P);
+    }
+
+    if (nrIndex >= 0) {
+      chunks[nrIndex] = nt;
+    }
+    if (npIndex >= 0) {
+      chunks[npIndex] = np;
+    }
+    nc_def_var_chunking(ncid, varid, chunks);
+  }
+  if (deflate > 0) {
+    nc_def_var_deflate(ncid, varid, shuffle ? 1 : 0, 1, deflate);
+  }
+}
+
+void bi::SimulatorNetCDFBuffer::plan() {
+  std::vector<int> dimids;
+  VarType type;
+  int i, id, j;
+
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    type = static_cast<VarType>(i);
+    plans[type].resize(vars[type].size());
+    for (id = 0; id < (int)vars[type].size(); ++id) {
+      if (vars[type][id] >= 0) {
+        VarPlan& plan = plans[type][id];
+        dimids = nc_inq_vardimid(ncid, vars[type][id]);
+        plan.offsets.resize(dimids.size(), 0);
+        plan.counts.resize(dimids.size(), 0);
+
+        for (j = 0; j < static_cast<int>(dimids.size()); ++j) {
+          if (dimids[j] == nrDim) {
+            plan.nrIndex = j;
+          } else if (dimids[j] == npDim) {
+            plan.npIndex = j;
+          } else if (dimids[j] == nrpDim) {
+            plan.nrpIndex = j;
+          } else {
+            plan.counts[j] = nc_inq_dimlen(ncid, dimids[j]);
+          }
+        }
+      }
+    }
+  }
+}
+
+void bi::SimulatorNetCDFBuffer::hyperslab(const VarType type, const int id,
+    const size_t k, const size_t K, const size_t p, const size_t P,
+    std::vector<size_t>& offsets, std::vector<size_t>& counts) const {
+  const VarPlan& plan = plans[type][id];
+
+  offsets = plan.offsets;
+  counts = plan.counts;
+  if (plan.nrIndex >= 0) {
+    offsets[plan.nrIndex] = k;
+    counts[plan.nrIndex] = K;
+  }
+  if (plan.npIndex >= 0) {
+    offsets[plan.npIndex] = p;
+    counts[plan.npIndex] = P;
+  }
+  if (plan.nrpIndex >= 0) {
+    /* pre-condition */
+    BI_ASSERT(K == 1);
+
+    offsets[plan.nrpIndex] = readStart(k);
+    counts[plan.nrpIndex] = readLen(k);
+  }
+}
+
+void bi::SimulatorNetCDFBuffer::flush(const VarType type) const {
+  WriteBatch& batch = batches[type];
+  std::vector<size_t> offsets, counts;
+  Var* var;
+  int id;
+
+  if (batch.len > 0) {
+    for (id = 0; id < m.getNumVars(type); ++id) {
+      var = m.getVar(type, id);
+      if (var->hasOutput() && vars[type][id] >= 0 &&
+          plans[type][id].nrIndex >= 0) {
+        hyperslab(type, id, batch.k, batch.len, batch.p, batch.X.size1(),
+            offsets, counts);
+        nc_put_vara(ncid, vars[type][id], offsets, counts,
+            columns(batch.X, flushInterval*var->getStart(),
+                batch.len*var->getSize()).buf());
+      }
+    }
+    batch.len = 0;
+  }
+}
+
+size_t bi::SimulatorNetCDFBuffer::getNumSamples() const {
+  /* pre-condition */
+  BI_ASSERT(npDim >= 0);
+
+  return nc_inq_dimlen(ncid, npDim);
+}
+
+size_t bi::SimulatorNetCDFBuffer::getNumTimes() const {
+  return nc_inq_dimlen(ncid, nrDim);
+}
+
+bi::SimulatorNetCDFBuffer::SchemaMode bi::SimulatorNetCDFBuffer::getSchema() const {
+  return static_cast<SchemaMode>(schema);
+}
+
 void bi::SimulatorNetCDFBuffer::readTime(const size_t k, real& t) const {
   nc_get_var1(ncid, tVar, k, &t);
 }
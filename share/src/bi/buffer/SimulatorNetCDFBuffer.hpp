@@ -47,6 +47,31 @@ public:
     FLEXI
   };
 
+  /**
+   * Chunking modes of variables along the time and sample dimensions.
+   */
+  enum ChunkMode {
+    /**
+     * Leave chunking to NetCDF.
+     */
+    DEFAULT_CHUNKS,
+
+    /**
+     * Chunks hold one time of many samples, matching writes of state.
+     */
+    TIME_CHUNKS,
+
+    /**
+     * Chunks hold many times of few samples, matching reads of trajectories.
+     */
+    TRAJECTORY_CHUNKS,
+
+    /**
+     * Chunks hold as many times as samples, a compromise between the two.
+     */
+    BALANCED_CHUNKS
+  };
+
   /**
    * Constructor.
    *
@@ -70,6 +95,71 @@ public:
       const std::string& file, const FileMode mode = READ_ONLY,
       const SchemaMode schema = DEFAULT);
 
+  /**
+   * Set chunking and compression of variables in buffers subsequently
+   * created.
+   *
+   * @param mode Chunking mode.
+   * @param deflate Deflate level, from 0 (no compression) to 9.
+   * @param shuffle Apply shuffle filter before deflate?
+   *
+   * Chunks span the whole of any model dimensions and hold about
+   * #CHUNK_BYTES, so that each fits in the default chunk cache of NetCDF.
+   * The mode sets their extent along the time (@c nr) and sample (@c np or
+   * @c nrp) dimensions.
+   */
+  static void setChunking(const ChunkMode mode, const int deflate = 0,
+      const bool shuffle = true);
+
+  /**
+   * Chunking mode from name.
+   *
+   * @param name One of @c "default", @c "time", @c "trajectory" or
+   * @c "balanced".
+   *
+   * @return Chunking mode.
+   */
+  static ChunkMode chunkMode(const std::string& name);
+
+  /**
+   * Destructor. Performs any writes of state still batched.
+   */
+  ~SimulatorNetCDFBuffer();
+
+  /**
+   * Set number of times to batch in writes of state.
+   *
+   * @param K Number of times.
+   *
+   * Writes of state at consecutive times, for the same samples, are copied
+   * and held until @p K times have accumulated, then each variable is
+   * written for all of them as one hyperslab along the @c nr dimension.
+   * This costs @p K copies of the state for each variable type, in return
+   * for far fewer, larger writes. The default of one writes through. Not
+   * used with the flexi schema.
+   */
+  void setFlushInterval(const int K);
+
+  /**
+   * Perform any writes of state still batched.
+   */
+  void flush();
+
+  /**
+   * Number of samples held in file. Not for the flexi schema.
+   */
+  size_t getNumSamples() const;
+
+  /**
+   * Number of times held in file.
+   */
+  size_t getNumTimes() const;
+
+  /**
+   * Schema mode.
+   */
+  SchemaMode getSchema() const;
+
   /**
    * Read time.
    *
@@ -319,6 +409,58 @@ protected:
    */
   int mapDim(Dim* dim);
 
+  /**
+   * Set chunking and compression of new variable, according to
+   * setChunking().
+   *
+   * @param varid Variable id.
+   */
+  void chunk(const int varid);
+
+  /**
+   * Plan reads and writes of all variables. Called once on create() or
+   * map(), so that dimensions need not be queried on each read or write.
+   */
+  void plan();
+
+  /**
+   * Compute hyperslab for read or write of variable.
+   *
+   * @param type Variable type.
+   * @param id Variable id.
+   * @param k First time index.
+   * @param K Number of times.
+   * @param p First sample index.
+   * @param P Number of samples.
+   * @param[out] offsets Offsets along each dimension.
+   * @param[out] counts Counts along each dimension.
+   */
+  void hyperslab(const VarType type, const int id, const size_t k,
+      const size_t K, const size_t p, const size_t P,
+      std::vector<size_t>& offsets, std::vector<size_t>& counts) const;
+
+  /**
+   * Write variable for a single time.
+   *
+   * @tparam M1 Matrix type.
+   *
+   * @param type Variable type.
+   * @param id Variable id.
+   * @param k Time index.
+   * @param p First sample index.
+   * @param X State. Rows index samples, columns variables.
+   */
+  template<class M1>
+  void writeVar(const VarType type, const int id, const size_t k,
+      const size_t p, const M1 X);
+
+  /**
+   * Perform any writes of state of variable type still batched.
+   *
+   * @param type Variable type.
+   */
+  void flush(const VarType type) const;
+
   /**
    * Read range of variable along single dimension.
    *
@@ -447,6 +589,92 @@ protected:
    * Model variables, indexed by type.
    */
   std::vector<std::vector<int> > vars;
+
+  /**
+   * Plan of reads and writes of a variable.
+   */
+  struct VarPlan {
+    VarPlan() : nrIndex(-1), npIndex(-1), nrpIndex(-1) {
+      //
+    }
+
+    /**
+     * Positions of @c nr, @c np and @c nrp dimensions, -1 if absent.
+     */
+    int nrIndex, npIndex, nrpIndex;
+
+    /**
+     * Offsets and counts along all dimensions, with those along model
+     * dimensions filled.
+     */
+    std::vector<size_t> offsets, counts;
+  };
+
+  /**
+   * Plans of model variables, indexed by type.
+   */
+  std::vector<std::vector<VarPlan> > plans;
+
+  /**
+   * Writes of state batched for a variable type.
+   */
+  struct WriteBatch {
+    WriteBatch() : k(0), p(0), len(0) {
+      //
+    }
+
+    /**
+     * State. Rows index samples. Columns hold the variables in turn, each
+     * over #flushInterval times, in the layout of the hyperslab written.
+     */
+    host_matrix<real> X;
+
+    /**
+     * First time index.
+     */
+    size_t k;
+
+    /**
+     * First sample index.
+     */
+    size_t p;
+
+    /**
+     * Number of times held.
+     */
+    size_t len;
+  };
+
+  /**
+   * Batched writes, indexed by type. Reads of a type perform its writes
+   * first, so are logically const.
+   */
+  mutable std::vector<WriteBatch> batches;
+
+  /**
+   * Number of times to batch in writes of state.
+   */
+  int flushInterval;
+
+  /**
+   * Target size of chunks, in bytes.
+   */
+  static const size_t CHUNK_BYTES = 1048576;
+
+  /**
+   * Chunking mode.
+   */
+  static ChunkMode chunking;
+
+  /**
+   * Deflate level.
+   */
+  static int deflate;
+
+  /**
+   * Apply shuffle filter?
+   */
+  static bool shuffle;
 };
 }
 
@@ -521,8 +749,9 @@ void bi::SimulatorNetCDFBuffer::readState(const VarType type, const size_t k,
 
   Var* var;
   std::vector<size_t> offsets, counts;
-  std::vector<int> dimids;
-  int start, size, id, i, j, varid;
+  int start, size, id, varid;
+
+  flush(type);
 
   for (id = 0; id < m.getNumVars(type); ++id) {
     var = m.getVar(type, id);
@@ -533,31 +762,7 @@ void bi::SimulatorNetCDFBuffer::readState(const VarType type, const size_t k,
       varid = vars[type][id];
       BI_ASSERT(varid >= 0);
 
-      j = 0;
-      dimids = nc_inq_vardimid(ncid, varid);
-      offsets.resize(dimids.size());
-      counts.resize(dimids.size());
-
-      if (j < dimids.size() && dimids[j] == nrDim) {
-        offsets[j] = k;
-        counts[j] = 1;
-        ++j;
-      }
-      for (i = var->getNumDims() - 1; i >= 0; --i) {
-        offsets[j] = 0;
-        counts[j] = nc_inq_dimlen(ncid, dimids[j]);
-        ++j;
-      }
-      if (j < dimids.size() && dimids[j] == npDim) {
-        offsets[j] = p;
-        counts[j] = X.size1();
-        ++j;
-      }
-      if (j < dimids.size() && dimids[j] == nrpDim) {
-        offsets[j] = readStart(k);
-        counts[j] = readLen(k);
-      }
-
+      hyperslab(type, id, k, 1, p, X.size1(), offsets, counts);
       if (M1::on_device || !X.contiguous()) {
         temp_matrix_type X1(X.size1(), size);
         nc_get_vara(ncid, varid, offsets, counts, X1.buf());
@@ -573,12 +778,8 @@ void bi::SimulatorNetCDFBuffer::readState(const VarType type, const size_t k,
 template<class M1>
 void bi::SimulatorNetCDFBuffer::writeState(const VarType type, const size_t k,
     const size_t p, const M1 X) {
-  typedef typename sim_temp_host_matrix<M1>::type temp_matrix_type;
-
   Var* var;
-  std::vector<size_t> offsets, counts;
-  std::vector<int> dimids;
-  int start, size, id, i, j, varid;
+  int start, size, id;
 
   if (schema == FLEXI) {
     /* write offset and length */
@@ -588,51 +789,67 @@ void bi::SimulatorNetCDFBuffer::writeState(const VarType type, const size_t k,
     writeLen(k, len);
   }
 
-  /* write data */
-  for (id = 0; id < m.getNumVars(type); ++id) {
-    var = m.getVar(type, id);
-    start = var->getStart();
-    size = var->getSize();
+  if (flushInterval > 1 && schema != FLEXI) {
+    /* batch variables along nr dimension, write others through */
+    WriteBatch& batch = batches[type];
+    if (batch.len > 0 && (k != batch.k + batch.len || p != batch.p ||
+        X.size1() != batch.X.size1())) {
+      flush(type);
+    }
+    if (batch.len == 0) {
+      batch.k = k;
+      batch.p = p;
+      batch.X.resize(X.size1(), flushInterval*m.getNetSize(type));
+    }
+    for (id = 0; id < m.getNumVars(type); ++id) {
+      var = m.getVar(type, id);
+      start = var->getStart();
+      size = var->getSize();
+
+      if (var->hasOutput()) {
+        if (vars[type][id] >= 0 && plans[type][id].nrIndex >= 0) {
+          columns(batch.X, flushInterval*start + batch.len*size, size) =
+              columns(X, start, size);
+        } else {
+          writeVar(type, id, k, p, X);
+        }
+      }
+    }
+    synchronize(M1::on_device);
+    ++batch.len;
+    if (batch.len == static_cast<size_t>(flushInterval)) {
+      flush(type);
+    }
+  } else {
+    for (id = 0; id < m.getNumVars(type); ++id) {
+      if (m.getVar(type, id)->hasOutput()) {
+        writeVar(type, id, k, p, X);
+      }
+    }
+  }
+}
 
-    if (var->hasOutput()) {
-      varid = vars[type][id];
-      BI_ASSERT(varid >= 0);
+template<class M1>
+void bi::SimulatorNetCDFBuffer::writeVar(const VarType type, const int id,
+    const size_t k, const size_t p, const M1 X) {
+  typedef typename sim_temp_host_matrix<M1>::type temp_matrix_type;
 
-      j = 0;
-      dimids = nc_inq_vardimid(ncid, varid);
-      offsets.resize(dimids.size());
-      counts.resize(dimids.size());
+  Var* var = m.getVar(type, id);
+  int start = var->getStart();
+  int size = var->getSize();
+  int varid = vars[type][id];
+  std::vector<size_t> offsets, counts;
 
-      if (j < static_cast<int>(dimids.size()) && dimids[j] == nrDim) {
-        offsets[j] = k;
-        counts[j] = 1;
-        ++j;
-      }
-      for (i = var->getNumDims() - 1; i >= 0; --i) {
-        offsets[j] = 0;
-        counts[j] = nc_inq_dimlen(ncid, dimids[j]);
-        ++j;
-      }
-      if (j < static_cast<int>(dimids.size()) && dimids[j] == npDim) {
-        offsets[j] = p;
-        counts[j] = X.size1();
-        ++j;
-      }
-      if (j < static_cast<int>(dimids.size()) && dimids[j] == nrpDim) {
-        offsets[j] = readStart(k);
-        counts[j] = readLen(k);
-      }
+  BI_ASSERT(varid >= 0);
 
-      if (M1::on_device || !X.contiguous()) {
-        temp_matrix_type X1(X.size1(), size);
-        X1 = columns(X, start, size);
-        synchronize(M1::on_device);
-        nc_put_vara(ncid, varid, offsets, counts, X1.buf());
-      } else {
-        nc_put_vara(ncid, varid, offsets, counts,
-            columns(X, start, size).buf());
-      }
-    }
+  hyperslab(type, id, k, 1, p, X.size1(), offsets, counts);
+  if (M1::on_device || !X.contiguous()) {
+    temp_matrix_type X1(X.size1(), size);
+    X1 = columns(X, start, size);
+    synchronize(M1::on_device);
+    nc_put_vara(ncid, varid, offsets, counts, X1.buf());
+  } else {
+    nc_put_vara(ncid, varid, offsets, counts, columns(X, start, size).buf());
   }
 }
 
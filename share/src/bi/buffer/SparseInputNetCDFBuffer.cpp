@@ -7,6 +7,9 @@
  */
 #include "SparseInputNetCDFBuffer.hpp"
 
+#include <set>
+#include <numeric>
+
 bi::SparseInputNetCDFBuffer::SparseInputNetCDFBuffer(const Model& m,
     const std::string& file, const long ns, const long np) :
     NetCDFBuffer(file), m(m), vars(NUM_VAR_TYPES), nsDim(-1), npDim(-1), ns(
@@ -14,10 +17,94 @@ bi::SparseInputNetCDFBuffer::SparseInputNetCDFBuffer(const Model& m,
   map();
 }
 
+bi::SparseInputNetCDFBuffer::~SparseInputNetCDFBuffer() {
+  int i, k;
+  for (i = 0; i < int(masks.size()); ++i) {
+    for (k = 0; k < int(masks[i].size()); ++k) {
+      delete masks[i][k];
+    }
+  }
+  for (i = 0; i < int(masks0.size()); ++i) {
+    delete masks0[i];
+  }
+}
+
+void bi::SparseInputNetCDFBuffer::preload() {
+  std::set<int> ncVars;
+  std::vector<std::vector<Mask<ON_HOST>*> > ms(NUM_VAR_TYPES);
+  std::vector<Mask<ON_HOST>*> ms0(NUM_VAR_TYPES);
+  VarType type;
+  size_t len, size;
+  int i, j, k;
+
+  if (!masks.empty()) {
+    /* already preloaded */
+    return;
+  }
+
+  /* variables to load, times having been read already by map() */
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    for (j = 0; j < int(vars[i].size()); ++j) {
+      if (vars[i][j] >= 0) {
+        ncVars.insert(vars[i][j]);
+      }
+    }
+  }
+  for (j = 0; j < int(coordVars.size()); ++j) {
+    if (coordVars[j] >= 0) {
+      ncVars.insert(coordVars[j]);
+    }
+  }
+
+  /* load variables in full, with lengths of their dimensions */
+  BOOST_AUTO(iter, ncVars.begin());
+  for (; iter != ncVars.end(); ++iter) {
+    Preload& pre = preloads[*iter];
+    pre.dimids = nc_inq_vardimid(ncid, *iter);
+    pre.strides.resize(pre.dimids.size());
+    size = 1;
+    for (j = int(pre.dimids.size()) - 1; j >= 0; --j) {
+      len = nc_inq_dimlen(ncid, pre.dimids[j]);
+      dimLens[pre.dimids[j]] = len;
+      pre.strides[j] = size;
+      size *= len;
+    }
+    pre.data.resize(size);
+    if (size > 0) {
+      nc_get_var(ncid, *iter, &pre.data[0]);
+    }
+  }
+  for (j = 0; j < int(recDims.size()); ++j) {
+    dimLens[recDims[j]] = nc_inq_dimlen(ncid, recDims[j]);
+  }
+  if (npDim >= 0) {
+    dimLens[npDim] = nc_inq_dimlen(ncid, npDim);
+  }
+
+  /* masks, built from the variables now in memory */
+  for (i = 0; i < NUM_VAR_TYPES; ++i) {
+    type = static_cast<VarType>(i);
+    ms0[i] = new Mask<ON_HOST>();
+    readMask0(type, *ms0[i]);
+
+    ms[i].resize(times.size());
+    for (k = 0; k < int(times.size()); ++k) {
+      ms[i][k] = new Mask<ON_HOST>();
+      readMask(k, type, *ms[i][k]);
+    }
+  }
+  masks.swap(ms);
+  masks0.swap(ms0);
+}
+
 void bi::SparseInputNetCDFBuffer::readMask(const size_t k, const VarType type,
     Mask<ON_HOST>& mask) {
   typedef typename temp_host_matrix<real>::type temp_matrix_type;
 
+  if (!masks.empty()) {
+    mask = *masks[type][k];
+    return;
+  }
   mask.resize(m.getNumVars(type), false);
 
   Var* var;
@@ -61,6 +148,11 @@ void bi::SparseInputNetCDFBuffer::readMask(const size_t k, const VarType type,
 void bi::SparseInputNetCDFBuffer::readMask0(const VarType type,
     Mask<ON_HOST>& mask) {
   typedef typename temp_host_matrix<real>::type temp_matrix_type;
+
+  if (!masks0.empty()) {
+    mask = *masks0[type];
+    return;
+  }
   mask.resize(m.getNumVars(type), false);
 
   Var* var;
@@ -75,7 +167,7 @@ void bi::SparseInputNetCDFBuffer::readMask0(const VarType type,
       BOOST_AUTO(end, range.second);
 
       start = 0;
-      len = nc_inq_dimlen(ncid, recDims[r]);
+      len = inqDimLen(recDims[r]);
 
       temp_matrix_type C(iter->second->getNumDims(), len);
       readCoords(coordVars[r], start, len, C);
@@ -362,3 +454,66 @@ void bi::SparseInputNetCDFBuffer::readTime(int ncVar, const long start,
     }
   }
 }
+
+std::vector<int> bi::SparseInputNetCDFBuffer::inqVarDimids(int ncVar) const {
+  BOOST_AUTO(iter, preloads.find(ncVar));
+  if (iter != preloads.end()) {
+    return iter->second.dimids;
+  } else {
+    return nc_inq_vardimid(ncid, ncVar);
+  }
+}
+
+size_t bi::SparseInputNetCDFBuffer::inqDimLen(int ncDim) const {
+  BOOST_AUTO(iter, dimLens.find(ncDim));
+  if (iter != dimLens.end()) {
+    return iter->second;
+  } else {
+    return nc_inq_dimlen(ncid, ncDim);
+  }
+}
+
+void bi::SparseInputNetCDFBuffer::getVara(int ncVar,
+    const std::vector<size_t>& offsets, const std::vector<size_t>& counts,
+    real* buf) const {
+  BOOST_AUTO(iter, preloads.find(ncVar));
+  if (iter == preloads.end()) {
+    nc_get_vara(ncid, ncVar, offsets, counts, buf);
+  } else {
+    const Preload& pre = iter->second;
+    const int D = pre.dimids.size();
+    int j;
+
+    /* pre-condition */
+    BI_ASSERT(int(offsets.size()) >= D && int(counts.size()) >= D);
+
+    if (D == 0) {
+      *buf = pre.data[0];
+      return;
+    }
+    for (j = 0; j < D; ++j) {
+      if (counts[j] == 0) {
+        return;
+      }
+      BI_ASSERT(offsets[j] + counts[j] <= inqDimLen(pre.dimids[j]));
+    }
+
+    /* copy contiguous runs along the last dimension, advancing the indices
+     * of the others in row major order */
+    std::vector<size_t> ixs(offsets.begin(), offsets.begin() + D);
+    const size_t n = counts[D - 1];
+    size_t from;
+    do {
+      from = std::inner_product(ixs.begin(), ixs.end(), pre.strides.begin(),
+          static_cast<size_t>(0));
+      std::copy(pre.data.begin() + from, pre.data.begin() + from + n, buf);
+      buf += n;
+
+      j = D - 2;
+      while (j >= 0 && ++ixs[j] == offsets[j] + counts[j]) {
+        ixs[j] = offsets[j];
+        --j;
+      }
+    } while (j >= 0);
+  }
+}
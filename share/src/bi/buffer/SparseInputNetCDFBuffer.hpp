@@ -37,6 +37,23 @@ public:
   SparseInputNetCDFBuffer(const Model& m, const std::string& file,
       const long ns = 0, const long np = -1);
 
+  /**
+   * Destructor.
+   */
+  ~SparseInputNetCDFBuffer();
+
+  /**
+   * Load the whole file into memory.
+   *
+   * Reads all coordinate and model variables in full, and builds the
+   * masks of all variable types at all times, after which reads are served
+   * from memory and make no further NetCDF calls. This suits methods that
+   * pass over the same inputs or observations many times, such as
+   * ParticleMarginalMetropolisHastings, trading memory for repeated reads,
+   * and must be called before any concurrent use of the buffer.
+   */
+  void preload();
+
   /**
    * Get time.
    *
@@ -231,6 +248,65 @@ private:
    */
   int mapCoordDim(int ncVar);
 
+  /**
+   * Inquire dimensions of variable, from memory if preloaded.
+   *
+   * @param ncVar Variable.
+   *
+   * @return Dimensions of variable.
+   */
+  std::vector<int> inqVarDimids(int ncVar) const;
+
+  /**
+   * Inquire length of dimension, from memory if preloaded.
+   *
+   * @param ncDim Dimension.
+   *
+   * @return Length of dimension.
+   */
+  size_t inqDimLen(int ncDim) const;
+
+  /**
+   * Read hyperslab of variable, from memory if preloaded.
+   *
+   * @param ncVar Variable.
+   * @param offsets Offsets along dimensions of variable.
+   * @param counts Extents along dimensions of variable.
+   * @param[out] buf Output buffer, row major, as for nc_get_vara().
+   */
+  void getVara(int ncVar, const std::vector<size_t>& offsets,
+      const std::vector<size_t>& counts, real* buf) const;
+
+  /**
+   * Preloaded variable.
+   */
+  struct Preload {
+    /**
+     * Dimensions.
+     */
+    std::vector<int> dimids;
+
+    /**
+     * Strides along dimensions, in elements.
+     */
+    std::vector<size_t> strides;
+
+    /**
+     * Values, row major, as in file.
+     */
+    std::vector<real> data;
+  };
+
+  /**
+   * Copy constructor, not implemented, as owns masks.
+   */
+  SparseInputNetCDFBuffer(const SparseInputNetCDFBuffer& o);
+
+  /**
+   * Assignment operator, not implemented, as owns masks.
+   */
+  SparseInputNetCDFBuffer& operator=(const SparseInputNetCDFBuffer& o);
+
   /**
    * Model.
    */
@@ -300,6 +376,27 @@ private:
    * Index of record to read along @c np dimension.
    */
   long np;
+
+  /**
+   * Preloaded variables, indexed by variable. Empty if not preloaded.
+   */
+  std::map<int,Preload> preloads;
+
+  /**
+   * Lengths of dimensions, indexed by dimension. Empty if not preloaded.
+   */
+  std::map<int,size_t> dimLens;
+
+  /**
+   * Masks of dynamic variables, indexed by type then time. Empty if not
+   * preloaded.
+   */
+  std::vector<std::vector<Mask<ON_HOST>*> > masks;
+
+  /**
+   * Masks of static variables, indexed by type. Empty if not preloaded.
+   */
+  std::vector<Mask<ON_HOST>*> masks0;
 };
 }
 
@@ -379,7 +476,7 @@ void bi::SparseInputNetCDFBuffer::readState0(const VarType type,
       BOOST_AUTO(end, range.second);
 
       start = 0;
-      len = nc_inq_dimlen(ncid, recDims[r]);
+      len = inqDimLen(recDims[r]);
 
       for (; iter != end; ++iter) {
         var = iter->second;
@@ -432,7 +529,7 @@ void bi::SparseInputNetCDFBuffer::readCoords(int ncVar, const long start,
   std::vector<int> dimids(3);
   int j = 0;
 
-  dimids = nc_inq_vardimid(ncid, ncVar);
+  dimids = inqVarDimids(ncVar);
 
   /* optional ns dimension */
   if (nsDim >= 0 && j < static_cast<int>(dimids.size()) && dimids[j] == nsDim) {
@@ -456,10 +553,10 @@ void bi::SparseInputNetCDFBuffer::readCoords(int ncVar, const long start,
   /* read */
   if (M1::on_device || !C.contiguous()) {
     typename sim_temp_matrix<M1>::type C1(C.size1(), C.size2());
-    nc_get_vara(ncid, ncVar, offsets, counts, C1.buf());
+    getVara(ncVar, offsets, counts, C1.buf());
     C = C1;
   } else {
-    nc_get_vara(ncid, ncVar, offsets, counts, C.buf());
+    getVara(ncVar, offsets, counts, C.buf());
   }
 }
 
@@ -472,7 +569,7 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
   typedef typename sim_temp_host_vector<M1>::type temp_vector_type;
   typedef typename sim_temp_host_matrix<M1>::type temp_matrix_type;
 
-  std::vector<int> dimids = nc_inq_vardimid(ncid, ncVar);
+  std::vector<int> dimids = inqVarDimids(ncVar);
   std::vector<size_t> offsets(dimids.size()), counts(dimids.size());
   int j = 0;
   bool haveP = false;
@@ -494,22 +591,22 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
   /* model dimensions */
   while (j < static_cast<int>(dimids.size()) && dimids[j] != npDim) {
     offsets[j] = 0;
-    counts[j] = nc_inq_dimlen(ncid, dimids[j]);
+    counts[j] = inqDimLen(dimids[j]);
     ++j;
   }
 
   /* np dimension */
   if (npDim >= 0 && j < static_cast<int>(dimids.size()) && dimids[j] == npDim) {
-    if (nc_inq_dimlen(ncid, npDim) == 1) {
+    if (inqDimLen(npDim) == 1) {
       /* special case, often occurring with simulated data sets */
       offsets[j] = 0;
       counts[j] = 1;
     } else if (np >= 0) {
-      BI_ASSERT(np < nc_inq_dimlen(ncid, npDim));
+      BI_ASSERT(np < inqDimLen(npDim));
       offsets[j] = np;
       counts[j] = 1;
     } else {
-      BI_ASSERT(X.size1() <= static_cast<int>(nc_inq_dimlen(ncid, npDim)));
+      BI_ASSERT(X.size1() <= static_cast<int>(inqDimLen(npDim)));
       offsets[j] = 0;
       counts[j] = X.size1();
       haveP = true;
@@ -520,14 +617,14 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
   /* read */
   if (!haveP && X.size1() > 1) {
     temp_vector_type x1(X.size2());
-    nc_get_vara(ncid, ncVar, offsets, counts, x1.buf());
+    getVara(ncVar, offsets, counts, x1.buf());
     set_rows(X, x1);
   } else if (M1::on_device || !X.contiguous()) {
     temp_matrix_type X1(X.size1(), X.size2());
-    nc_get_vara(ncid, ncVar, offsets, counts, X1.buf());
+    getVara(ncVar, offsets, counts, X1.buf());
     X = X1;
   } else {
-    nc_get_vara(ncid, ncVar, offsets, counts, X.buf());
+    getVara(ncVar, offsets, counts, X.buf());
   }
 }
 
@@ -541,7 +638,7 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
   typedef typename sim_temp_host_vector<M1>::type temp_vector_type;
   typedef typename sim_temp_host_matrix<M1>::type temp_matrix_type;
 
-  std::vector<int> dimids = nc_inq_vardimid(ncid, ncVar);
+  std::vector<int> dimids = inqVarDimids(ncVar);
   std::vector<size_t> offsets(dimids.size()), counts(dimids.size());
   int j = 0;
   bool haveP = false;
@@ -562,11 +659,11 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
   /* np dimension */
   if (npDim >= 0 && j < static_cast<int>(dimids.size()) && dimids[j] == npDim) {
     if (np >= 0) {
-      BI_ASSERT(np + X.size1() <= nc_inq_dimlen(ncid, npDim));
+      BI_ASSERT(np + X.size1() <= inqDimLen(npDim));
       offsets[j] = np;
       counts[j] = 1;
     } else {
-      BI_ASSERT(X.size1() <= static_cast<int>(nc_inq_dimlen(ncid, npDim)));
+      BI_ASSERT(X.size1() <= static_cast<int>(inqDimLen(npDim)));
       offsets[j] = 0;
       counts[j] = X.size1();
       haveP = true;
@@ -576,13 +673,13 @@ void bi::SparseInputNetCDFBuffer::readVar(int ncVar, const long start,
 
   if (!haveP && X.size1() > 1) {
     temp_vector_type x1(static_cast<int>(len));
-    nc_get_vara(ncid, ncVar, offsets, counts, x1.buf());
+    getVara(ncVar, offsets, counts, x1.buf());
     for (j = 0; j < static_cast<int>(len); ++j) {
       set_elements(column(X, ixs(j)), x1(j));
     }
   } else {
     temp_matrix_type X1(X.size1(), static_cast<int>(len));
-    nc_get_vara(ncid, ncVar, offsets, counts, X1.buf());
+    getVara(ncVar, offsets, counts, X1.buf());
     for (j = 0; j < static_cast<int>(len); ++j) {
       ///@todo This could be improved for contiguous columns
       column(X, ixs(j)) = column(X1, j);
@@ -0,0 +1,163 @@
+/**
+ * @file
+ *
+ * Conversion of output files between buffer types, such as between NetCDF
+ * and memory-mapped files.
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_BUFFER_CONVERT_HPP
+#define BI_BUFFER_CONVERT_HPP
+
+#include "SimulatorNetCDFBuffer.hpp"
+#include "MmapSimulatorBuffer.hpp"
+#include "../model/Model.hpp"
+
+namespace bi {
+/**
+ * Schema of memory-mapped file corresponding to that of NetCDF file.
+ *
+ * @ingroup io_buffer
+ *
+ * @param schema Schema of NetCDF file. The flexi schema has no
+ * counterpart, and is an error.
+ *
+ * @return Schema of memory-mapped file.
+ */
+MmapSimulatorBuffer::SchemaMode convertSchema(
+    const SimulatorNetCDFBuffer::SchemaMode schema);
+
+/**
+ * Schema of NetCDF file corresponding to that of memory-mapped file.
+ *
+ * @ingroup io_buffer
+ *
+ * @param schema Schema of memory-mapped file.
+ *
+ * @return Schema of NetCDF file.
+ */
+SimulatorNetCDFBuffer::SchemaMode convertSchema(
+    const MmapSimulatorBuffer::SchemaMode schema);
+
+/**
+ * Copy results of Simulator from one buffer to another.
+ *
+ * @ingroup io_buffer
+ *
+ * @tparam IO1 Input buffer type, e.g. SimulatorNetCDFBuffer.
+ * @tparam IO2 Output buffer type, e.g. MmapSimulatorBuffer.
+ *
+ * @param m Model.
+ * @param in Input buffer.
+ * @param[out] out Output buffer, with the same numbers of samples and times
+ * as @p in, and the corresponding schema.
+ *
+ * Times, parameters and state are copied one time at a time, so that no
+ * more than one time of state is held in memory.
+ */
+template<class IO1, class IO2>
+void convertSimulator(const Model& m, IO1& in, IO2& out);
+
+/**
+ * Copy results of a particle filter from one buffer to another.
+ *
+ * @ingroup io_buffer
+ *
+ * @tparam IO1 Input buffer type, e.g. ParticleFilterNetCDFBuffer.
+ * @tparam IO2 Output buffer type, e.g. MmapParticleFilterBuffer.
+ *
+ * @param m Model.
+ * @param in Input buffer.
+ * @param[out] out Output buffer, as for convertSimulator().
+ *
+ * As convertSimulator(), and also copies log-weights, ancestors and the
+ * marginal log-likelihood estimate.
+ */
+template<class IO1, class IO2>
+void convertParticleFilter(const Model& m, IO1& in, IO2& out);
+}
+
+#include "../math/matrix.hpp"
+#include "../math/vector.hpp"
+#include "../misc/assert.hpp"
+
+inline bi::MmapSimulatorBuffer::SchemaMode bi::convertSchema(
+    const SimulatorNetCDFBuffer::SchemaMode schema) {
+  switch (schema) {
+  case SimulatorNetCDFBuffer::MULTI:
+    return MmapSimulatorBuffer::MULTI;
+  case SimulatorNetCDFBuffer::PARAM_ONLY:
+    return MmapSimulatorBuffer::PARAM_ONLY;
+  default:
+    BI_ERROR_MSG(schema == SimulatorNetCDFBuffer::DEFAULT,
+        "Flexi schema cannot be held in memory-mapped file");
+    return MmapSimulatorBuffer::DEFAULT;
+  }
+}
+
+inline bi::SimulatorNetCDFBuffer::SchemaMode bi::convertSchema(
+    const MmapSimulatorBuffer::SchemaMode schema) {
+  switch (schema) {
+  case MmapSimulatorBuffer::MULTI:
+    return SimulatorNetCDFBuffer::MULTI;
+  case MmapSimulatorBuffer::PARAM_ONLY:
+    return SimulatorNetCDFBuffer::PARAM_ONLY;
+  default:
+    return SimulatorNetCDFBuffer::DEFAULT;
+  }
+}
+
+template<class IO1, class IO2>
+void bi::convertSimulator(const Model& m, IO1& in, IO2& out) {
+  const size_t P = in.getNumSamples();
+  const size_t T = in.getNumTimes();
+  const size_t Q = (in.getSchema() == IO1::DEFAULT) ? 1 : P;
+  size_t k;
+
+  /* pre-conditions */
+  BI_ERROR_MSG(out.getNumSamples() == P,
+      "Output has " << out.getNumSamples() << " samples, should have " << P);
+  BI_ERROR_MSG(out.getNumTimes() == T,
+      "Output has " << out.getNumTimes() << " times, should have " << T);
+
+  host_matrix<real> X(Q, m.getNetSize(P_VAR));
+  in.readParameters(X);
+  out.writeParameters(X);
+
+  if (in.getSchema() != IO1::PARAM_ONLY) {
+    host_vector<real> ts(T);
+    in.readTimes(0, ts);
+    out.writeTimes(0, ts);
+
+    X.resize(P, m.getDynSize(), false);
+    for (k = 0; k < T; ++k) {
+      in.readState(k, X);
+      out.writeState(k, X);
+    }
+  }
+}
+
+template<class IO1, class IO2>
+void bi::convertParticleFilter(const Model& m, IO1& in, IO2& out) {
+  convertSimulator(m, in, out);
+
+  const size_t P = in.getNumSamples();
+  const size_t T = in.getNumTimes();
+  host_vector<real> lws(P);
+  host_vector<int> as(P);
+  real ll;
+  size_t k;
+
+  for (k = 0; k < T; ++k) {
+    in.readLogWeights(k, lws);
+    out.writeLogWeights(k, lws);
+    in.readAncestors(k, as);
+    out.writeAncestors(k, as);
+  }
+  in.readLL(ll);
+  out.writeLL(ll);
+}
+
+#endif
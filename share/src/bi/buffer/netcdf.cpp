@@ -10,7 +10,31 @@
 #include "../misc/assert.hpp"
 #include "../misc/compile.hpp"
 
+#include <pthread.h>
+
+namespace {
+/**
+ * Mutex serialising calls into NetCDF, which is not thread safe, so that
+ * WriteQueue may write from its background thread while other threads read.
+ */
+pthread_mutex_t ncMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Holds #ncMutex for its lifetime.
+ */
+struct NetCDFLock {
+  NetCDFLock() {
+    pthread_mutex_lock(&ncMutex);
+  }
+
+  ~NetCDFLock() {
+    pthread_mutex_unlock(&ncMutex);
+  }
+};
+}
+
 int bi::nc_open(const std::string& path, int mode) {
+  NetCDFLock lock;
   int ncid, status;
   status = ::nc_open(path.c_str(), mode, &ncid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not open " << path);
@@ -19,6 +43,7 @@ int bi::nc_open(const std::string& path, int mode) {
 }
 
 int bi::nc_create(const std::string& path, int cmode) {
+  NetCDFLock lock;
   int ncid, status;
   status = ::nc_create(path.c_str(), cmode, &ncid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not create " << path);
@@ -26,31 +51,37 @@ int bi::nc_create(const std::string& path, int cmode) {
 }
 
 void bi::nc_set_fill(int ncid, int fillmode) {
+  NetCDFLock lock;
   int status = ::nc_set_fill(ncid, fillmode, NULL);
   BI_WARN_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_sync(int ncid) {
+  NetCDFLock lock;
   int status = ::nc_sync(ncid);
   BI_WARN_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_redef(int ncid) {
+  NetCDFLock lock;
   int status = ::nc_redef(ncid);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_enddef(int ncid) {
+  NetCDFLock lock;
   int status = ::nc_enddef(ncid);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_close(int ncid) {
+  NetCDFLock lock;
   int status = ::nc_close(ncid);
   BI_WARN_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 int bi::nc_inq_nvars(int ncid) {
+  NetCDFLock lock;
   int nvars, status;
   status = ::nc_inq_nvars(ncid, &nvars);
   BI_ERROR_MSG(status == NC_NOERR, "Could not determine number of variables");
@@ -58,6 +89,7 @@ int bi::nc_inq_nvars(int ncid) {
 }
 
 int bi::nc_def_dim(int ncid, const std::string& name, size_t len) {
+  NetCDFLock lock;
   int dimid, status;
   status = ::nc_def_dim(ncid, name.c_str(), len, &dimid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define dimension " << name);
@@ -65,6 +97,7 @@ int bi::nc_def_dim(int ncid, const std::string& name, size_t len) {
 }
 
 int bi::nc_def_dim(int ncid, const std::string& name) {
+  NetCDFLock lock;
   int dimid, status;
   status = ::nc_def_dim(ncid, name.c_str(), NC_UNLIMITED, &dimid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define dimension " << name);
@@ -72,6 +105,7 @@ int bi::nc_def_dim(int ncid, const std::string& name) {
 }
 
 int bi::nc_inq_dimid(int ncid, const std::string& name) {
+  NetCDFLock lock;
   int dimid = -1;
   BI_UNUSED int status;
   status = ::nc_inq_dimid(ncid, name.c_str(), &dimid);
@@ -79,6 +113,7 @@ int bi::nc_inq_dimid(int ncid, const std::string& name) {
 }
 
 std::string bi::nc_inq_dimname(int ncid, int dimid) {
+  NetCDFLock lock;
   char name[NC_MAX_NAME + 1];
   int status;
   status = ::nc_inq_dimname(ncid, dimid, name);
@@ -87,6 +122,7 @@ std::string bi::nc_inq_dimname(int ncid, int dimid) {
 }
 
 size_t bi::nc_inq_dimlen(int ncid, int dimid) {
+  NetCDFLock lock;
   size_t len;
   int status;
   status = ::nc_inq_dimlen(ncid, dimid, &len);
@@ -96,6 +132,7 @@ size_t bi::nc_inq_dimlen(int ncid, int dimid) {
 
 int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
     const std::vector<int>& dimids) {
+  NetCDFLock lock;
   int varid, status;
   status = ::nc_def_var(ncid, name.c_str(), xtype, dimids.size(),
       dimids.data(), &varid);
@@ -104,6 +141,7 @@ int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
 }
 
 int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype) {
+  NetCDFLock lock;
   int varid, status;
   status = ::nc_def_var(ncid, name.c_str(), xtype, 0, NULL, &varid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define variable " << name);
@@ -112,6 +150,7 @@ int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype) {
 
 int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
     int dimid) {
+  NetCDFLock lock;
   int varid, status;
   status = ::nc_def_var(ncid, name.c_str(), xtype, 1, &dimid, &varid);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define variable " << name);
@@ -120,6 +159,7 @@ int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
 
 int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
     int dimid1, int dimid2) {
+  NetCDFLock lock;
   int varid, status;
   int dims[2] = { dimid1, dimid2 };
   status = ::nc_def_var(ncid, name.c_str(), xtype, 2, dims, &varid);
@@ -128,6 +168,7 @@ int bi::nc_def_var(int ncid, const std::string& name, nc_type xtype,
 }
 
 int bi::nc_inq_varid(int ncid, const std::string& name) {
+  NetCDFLock lock;
   int varid = -1;
   BI_UNUSED int status;
   status = ::nc_inq_varid(ncid, name.c_str(), &varid);
@@ -135,6 +176,7 @@ int bi::nc_inq_varid(int ncid, const std::string& name) {
 }
 
 std::string bi::nc_inq_varname(int ncid, int varid) {
+  NetCDFLock lock;
   char name[NC_MAX_NAME + 1];
   int status;
   status = ::nc_inq_varname(ncid, varid, name);
@@ -143,6 +185,7 @@ std::string bi::nc_inq_varname(int ncid, int varid) {
 }
 
 int bi::nc_inq_varndims(int ncid, int varid) {
+  NetCDFLock lock;
   int ndims, status;
   status = ::nc_inq_varndims(ncid, varid, &ndims);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -150,128 +193,167 @@ int bi::nc_inq_varndims(int ncid, int varid) {
 }
 
 std::vector<int> bi::nc_inq_vardimid(int ncid, int varid) {
-  int ndims = nc_inq_varndims(ncid, varid);
+  NetCDFLock lock;
+  int ndims, status;
+  status = ::nc_inq_varndims(ncid, varid, &ndims);
+  BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
   std::vector<int> dimids(ndims);
   if (ndims > 0) {
-    int status = ::nc_inq_vardimid(ncid, varid, dimids.data());
+    status = ::nc_inq_vardimid(ncid, varid, dimids.data());
     BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
   }
   return dimids;
 }
 
+void bi::nc_def_var_chunking(int ncid, int varid,
+    const std::vector<size_t>& chunksizes) {
+  NetCDFLock lock;
+  int status = ::nc_def_var_chunking(ncid, varid, NC_CHUNKED,
+      chunksizes.data());
+  BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
+}
+
+void bi::nc_def_var_deflate(int ncid, int varid, int shuffle, int deflate,
+    int level) {
+  NetCDFLock lock;
+  int status = ::nc_def_var_deflate(ncid, varid, shuffle, deflate, level);
+  BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
+}
+
 void bi::nc_put_att(int ncid, const std::string& name,
     const std::string& value) {
+  NetCDFLock lock;
   int status = ::nc_put_att_text(ncid, NC_GLOBAL, name.c_str(),
       value.length(), value.c_str());
   BI_ERROR_MSG(status == NC_NOERR, "Could not define attribute " << name);
 }
 
 void bi::nc_put_att(int ncid, const std::string& name, const int value) {
+  NetCDFLock lock;
   int status = ::nc_put_att_int(ncid, NC_GLOBAL, name.c_str(), NC_INT, 1,
       &value);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define attribute " << name);
 }
 
 void bi::nc_put_att(int ncid, const std::string& name, const float value) {
+  NetCDFLock lock;
   int status = ::nc_put_att_float(ncid, NC_GLOBAL, name.c_str(), NC_FLOAT, 1,
       &value);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define attribute " << name);
 }
 
 void bi::nc_put_att(int ncid, const std::string& name, const double value) {
+  NetCDFLock lock;
   int status = ::nc_put_att_double(ncid, NC_GLOBAL, name.c_str(), NC_DOUBLE,
       1, &value);
   BI_ERROR_MSG(status == NC_NOERR, "Could not define attribute " << name);
 }
 
 void bi::nc_get_var(int ncid, int varid, int* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var_int(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var(int ncid, int varid, long* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var_long(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var(int ncid, int varid, float* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var_float(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var(int ncid, int varid, double* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var_double(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var(int ncid, int varid, const int* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var_int(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var(int ncid, int varid, const long* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var_long(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var(int ncid, int varid, const float* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var_float(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var(int ncid, int varid, const double* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var_double(ncid, varid, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const size_t index, int* ip) {
+  NetCDFLock lock;
   int status;
   status = ::nc_get_var1_int(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const size_t index, long* ip) {
+  NetCDFLock lock;
   int status;
   status = ::nc_get_var1_long(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const size_t index, float* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var1_float(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const size_t index, double* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var1_double(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const size_t index,
     const int* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_int(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const size_t index,
     const long* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_long(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const size_t index,
     const float* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_float(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const size_t index,
     const double* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_double(ncid, varid, &index, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
     int* ip) {
+  NetCDFLock lock;
   int status;
   status = ::nc_get_var1_int(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -279,6 +361,7 @@ void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
 
 void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
     long* ip) {
+  NetCDFLock lock;
   int status;
   status = ::nc_get_var1_long(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -286,90 +369,105 @@ void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
 
 void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
     float* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var1_float(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_var1(int ncid, int varid, const std::vector<size_t>& index,
     double* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_var1_double(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const std::vector<size_t>& index,
     const int* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_int(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const std::vector<size_t>& index,
     const long* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_long(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const std::vector<size_t>& index,
     const float* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_float(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_var1(int ncid, int varid, const std::vector<size_t>& index,
     const double* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_var1_double(ncid, varid, index.data(), ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_vara(int ncid, int varid, const size_t start,
     const size_t count, int* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_int(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_vara(int ncid, int varid, const size_t start,
     const size_t count, long* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_long(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_vara(int ncid, int varid, const size_t start,
     const size_t count, float* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_float(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_vara(int ncid, int varid, const size_t start,
     const size_t count, double* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_double(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_vara(int ncid, int varid, const size_t start,
     const size_t count, const int* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_int(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_vara(int ncid, int varid, const size_t start,
     const size_t count, const long* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_long(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_vara(int ncid, int varid, const size_t start,
     const size_t count, const float* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_float(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_put_vara(int ncid, int varid, const size_t start,
     const size_t count, const double* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_double(ncid, varid, &start, &count, ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
 }
 
 void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, int* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_int(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -377,6 +475,7 @@ void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, long* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_long(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -384,6 +483,7 @@ void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, float* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_float(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -391,6 +491,7 @@ void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, double* ip) {
+  NetCDFLock lock;
   int status = ::nc_get_vara_double(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -398,6 +499,7 @@ void bi::nc_get_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, const int* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_int(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -405,6 +507,7 @@ void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, const long* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_long(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -412,6 +515,7 @@ void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, const float* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_float(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
@@ -419,6 +523,7 @@ void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
 
 void bi::nc_put_vara(int ncid, int varid, const std::vector<size_t>& start,
     const std::vector<size_t>& count, const double* ip) {
+  NetCDFLock lock;
   int status = ::nc_put_vara_double(ncid, varid, start.data(), count.data(),
       ip);
   BI_ERROR_MSG(status == NC_NOERR, nc_strerror(status));
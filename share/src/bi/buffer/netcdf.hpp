@@ -10,8 +10,10 @@
  *
  * @li provide error handling consistent with LibBi error reporting,
  * @li provide return values where convenient once error codes are handled
- * internally, and
- * @li provide generic or overloaded functions where convenient.
+ * internally,
+ * @li provide generic or overloaded functions where convenient, and
+ * @li serialise calls, as NetCDF is not thread safe, so that WriteQueue may
+ * write from its background thread.
  *
  * Note that the older NetCDF C++ Interface does not support certain features
  * of NetCDF 4 that have become necessary in LibBi, while the newer interface
@@ -186,6 +188,32 @@ int nc_inq_varndims(int ncid, int varid);
  * @ingroup io_buffer
  */
 std::vector<int> nc_inq_vardimid(int ncid, int varid);
+
+/**
+ * Set chunk sizes of variable.
+ *
+ * @ingroup io_buffer
+ *
+ * @param ncid
+ * @param varid
+ * @param chunksizes Chunk size along each dimension of the variable.
+ */
+void nc_def_var_chunking(int ncid, int varid,
+    const std::vector<size_t>& chunksizes);
+
+/**
+ * Set compression of variable.
+ *
+ * @ingroup io_buffer
+ *
+ * @param ncid
+ * @param varid
+ * @param shuffle Nonzero to apply shuffle filter.
+ * @param deflate Nonzero to apply deflate filter.
+ * @param level Deflate level, 0 to 9.
+ */
+void nc_def_var_deflate(int ncid, int varid, int shuffle, int deflate,
+    int level);
 //@}
 
 /**
@@ -24,6 +24,9 @@ namespace bi {
  *
  * @ingroup io_cache
  *
+ * Writes of log-weights and ancestors, like those of state, are performed in
+ * the background by writeQueue().
+ *
  * @tparam IO1 Buffer type.
  * @tparam CL Location.
  */
@@ -244,6 +247,7 @@ void bi::ParticleFilterCache<IO1,CL>::readLogWeights(const int k,
     V1 lws) const {
   BI_ASSERT(out != NULL);
 
+  writeQueue().flush();
   out->readLogWeights(k, lws);
 }
 
@@ -252,7 +256,7 @@ template<class V1>
 void bi::ParticleFilterCache<IO1,CL>::writeLogWeights(const int k,
     const V1 lws) {
   if (out != NULL) {
-    out->writeLogWeights(k, lws);
+    writeQueue().push(new LogWeightsWriteJob<IO1>(out, k, lws));
   }
   logWeightsCache.resize(lws.size());
   logWeightsCache.set(0, lws.size(), lws);
@@ -264,6 +268,7 @@ void bi::ParticleFilterCache<IO1,CL>::readAncestors(const int k,
     V1 as) const {
   BI_ASSERT(out != NULL);
 
+  writeQueue().flush();
   out->readAncestors(k, as);
 }
 
@@ -272,13 +277,14 @@ template<class V1>
 void bi::ParticleFilterCache<IO1,CL>::writeAncestors(const int k,
     const V1 as) {
   if (out != NULL) {
-    out->writeAncestors(k, as);
+    writeQueue().push(new AncestorsWriteJob<IO1>(out, k, as));
   }
 }
 
 template<class IO1, bi::Location CL>
 inline void bi::ParticleFilterCache<IO1,CL>::writeLL(const real ll) {
   if (out != NULL) {
+    writeQueue().flush();
     out->writeLL(ll);
   }
 }
@@ -456,6 +456,7 @@ void bi::ParticleMCMCCache<IO1,CL>::empty() {
 template<class IO1, bi::Location CL>
 void bi::ParticleMCMCCache<IO1,CL>::flush() {
   if (out != NULL) {
+    writeQueue().flush();
     out->writeLogLikelihoods(first, llCache.get(0, len));
     out->writeLogPriors(first, lpCache.get(0, len));
     out->writeParameters(first, parameterCache.get(0, len));
@@ -468,6 +469,7 @@ void bi::ParticleMCMCCache<IO1,CL>::flush() {
       out->writeState(k, first, trajectoryCache[k]->get(0, len));
       trajectoryCache[k]->flush();
     }
+    out->flush();
   }
 }
 
@@ -0,0 +1,360 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_CACHE_READAHEAD_HPP
+#define BI_CACHE_READAHEAD_HPP
+
+#include "../state/Mask.hpp"
+#include "../math/matrix.hpp"
+#include "../model/Var.hpp"
+#include "../cuda/cuda.hpp"
+
+#include <deque>
+#include <pthread.h>
+
+namespace bi {
+/**
+ * Sequential reads of masks and values of a variable type from an input
+ * buffer, read ahead by a background thread.
+ *
+ * @ingroup io_cache
+ *
+ * @tparam IO1 Input type.
+ *
+ * Each read of time index @c k by readState() queues reads of the following
+ * times, up to a fixed number, which the background thread performs while
+ * the caller proceeds. If the caller next asks for <tt>k + 1</tt>, as a
+ * filter or simulation does, the read has usually been performed already.
+ * Reads of any other time, such as on the first call or on a jump
+ * backwards, are performed immediately and restart the sequence.
+ *
+ * Values read are written over those of the previous time, as when reading
+ * repeatedly into the same state, so that values not masked at a time are
+ * carried forward.
+ *
+ * Calls into NetCDF from the background thread and any other are serialised
+ * within the wrappers of netcdf.hpp. With CUDA enabled, reads are not read
+ * ahead, as temporaries on host are then drawn from per-thread pools that
+ * the background thread cannot safely share.
+ */
+template<class IO1>
+class ReadAhead {
+public:
+  /**
+   * Constructor. Starts background thread.
+   *
+   * @param in Input.
+   * @param type Variable type.
+   * @param N Number of times to read ahead. Zero to read only on demand.
+   */
+  ReadAhead(IO1* in, const VarType type, const int N);
+
+  /**
+   * Destructor. Stops background thread.
+   */
+  ~ReadAhead();
+
+  /**
+   * Read mask. Does not advance the sequence.
+   *
+   * @param k Time index.
+   * @param[out] mask Mask.
+   */
+  void readMask(const int k, Mask<ON_HOST>& mask);
+
+  /**
+   * Read mask and values, and read ahead.
+   *
+   * @tparam M1 Matrix type.
+   *
+   * @param k Time index.
+   * @param[out] mask Mask.
+   * @param[in,out] X State. Values at time @p k are written over those of
+   * the previous time.
+   */
+  template<class M1>
+  void readState(const int k, Mask<ON_HOST>& mask, M1 X);
+
+private:
+  /**
+   * Read of one time.
+   */
+  struct Entry {
+    /**
+     * Time index.
+     */
+    int k;
+
+    /**
+     * Mask.
+     */
+    Mask<ON_HOST> mask;
+
+    /**
+     * State after read.
+     */
+    host_matrix<real> X;
+
+    /**
+     * Has read been performed?
+     */
+    bool ready;
+  };
+
+  /**
+   * Copy constructor, not implemented, as owns thread.
+   */
+  ReadAhead(const ReadAhead<IO1>& o);
+
+  /**
+   * Assignment operator, not implemented, as owns thread.
+   */
+  ReadAhead<IO1>& operator=(const ReadAhead<IO1>& o);
+
+  /**
+   * Entry point of background thread.
+   */
+  static void* start(void* ahead);
+
+  /**
+   * Perform reads until stopped.
+   */
+  void run();
+
+  /**
+   * Queued entry for time index, NULL if none. Caller holds #mutex.
+   */
+  Entry* find(const int k);
+
+  /**
+   * Remove all queued entries, waiting for any in progress. Caller holds
+   * #mutex.
+   */
+  void clear();
+
+  /**
+   * Input.
+   */
+  IO1* in;
+
+  /**
+   * Variable type.
+   */
+  VarType type;
+
+  /**
+   * Number of times to read ahead.
+   */
+  int N;
+
+  /**
+   * Reads queued, in order of time, those performed first.
+   */
+  std::deque<Entry*> entries;
+
+  /**
+   * State after last read of background thread, to which the next is
+   * applied.
+   */
+  host_matrix<real> X;
+
+  /**
+   * Is the background thread reading?
+   */
+  bool busy;
+
+  /**
+   * Has the background thread been asked to stop?
+   */
+  bool stopped;
+
+  /**
+   * Background thread.
+   */
+  pthread_t thread;
+
+  /**
+   * Mutex guarding all of the above.
+   */
+  pthread_mutex_t mutex;
+
+  /**
+   * Signalled whenever entries change.
+   */
+  pthread_cond_t changed;
+};
+}
+
+#include "../misc/assert.hpp"
+
+template<class IO1>
+bi::ReadAhead<IO1>::ReadAhead(IO1* in, const VarType type, const int N) :
+    in(in), type(type), N(N), busy(false), stopped(false) {
+  /* pre-condition */
+  BI_ASSERT(N >= 0);
+
+  #ifdef ENABLE_CUDA
+  this->N = 0;
+  #endif
+
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&changed, NULL);
+  if (this->N > 0) {
+    BI_ERROR_MSG(pthread_create(&thread, NULL, &ReadAhead<IO1>::start,
+        this) == 0, "Could not start input thread");
+  }
+}
+
+template<class IO1>
+bi::ReadAhead<IO1>::~ReadAhead() {
+  pthread_mutex_lock(&mutex);
+  clear();
+  stopped = true;
+  pthread_cond_broadcast(&changed);
+  pthread_mutex_unlock(&mutex);
+
+  if (N > 0) {
+    pthread_join(thread, NULL);
+  }
+  pthread_cond_destroy(&changed);
+  pthread_mutex_destroy(&mutex);
+}
+
+template<class IO1>
+void bi::ReadAhead<IO1>::readMask(const int k, Mask<ON_HOST>& mask) {
+  Entry* e;
+
+  pthread_mutex_lock(&mutex);
+  e = find(k);
+  if (e != NULL) {
+    while (!e->ready) {
+      pthread_cond_wait(&changed, &mutex);
+    }
+    mask = e->mask;
+    pthread_mutex_unlock(&mutex);
+  } else {
+    pthread_mutex_unlock(&mutex);
+    in->readMask(k, type, mask);
+  }
+}
+
+template<class IO1>
+template<class M1>
+void bi::ReadAhead<IO1>::readState(const int k, Mask<ON_HOST>& mask,
+    M1 X) {
+  Entry* e;
+  int last;
+
+  pthread_mutex_lock(&mutex);
+  if (!entries.empty() && entries.front()->k == k) {
+    /* read ahead */
+    e = entries.front();
+    while (!e->ready) {
+      pthread_cond_wait(&changed, &mutex);
+    }
+    entries.pop_front();
+    pthread_mutex_unlock(&mutex);
+
+    mask = e->mask;
+    X = e->X;
+    synchronize(M1::on_device);
+    delete e;
+
+    pthread_mutex_lock(&mutex);
+  } else {
+    /* read now, and restart sequence from here */
+    clear();
+    pthread_mutex_unlock(&mutex);
+
+    in->readMask(k, type, mask);
+    in->readState(k, type, mask, X);
+
+    pthread_mutex_lock(&mutex);
+    this->X.resize(X.size1(), X.size2());
+    this->X = X;
+    synchronize(M1::on_device);
+  }
+
+  /* queue reads of following times */
+  last = entries.empty() ? k : entries.back()->k;
+  while ((int)entries.size() < N && last + 1 < (int)in->getTimes().size()) {
+    e = new Entry();
+    e->k = ++last;
+    e->ready = false;
+    entries.push_back(e);
+  }
+  pthread_cond_broadcast(&changed);
+  pthread_mutex_unlock(&mutex);
+}
+
+template<class IO1>
+void* bi::ReadAhead<IO1>::start(void* ahead) {
+  static_cast<ReadAhead<IO1>*>(ahead)->run();
+  return NULL;
+}
+
+template<class IO1>
+void bi::ReadAhead<IO1>::run() {
+  Entry* e;
+  int i;
+
+  pthread_mutex_lock(&mutex);
+  while (true) {
+    /* first entry not yet read */
+    e = NULL;
+    for (i = 0; e == NULL && i < (int)entries.size(); ++i) {
+      if (!entries[i]->ready) {
+        e = entries[i];
+      }
+    }
+    if (e == NULL) {
+      if (stopped) {
+        break;
+      }
+      pthread_cond_wait(&changed, &mutex);
+    } else {
+      /* entry stays queued while in progress, and clear() waits for it */
+      busy = true;
+      pthread_mutex_unlock(&mutex);
+
+      in->readMask(e->k, type, e->mask);
+      in->readState(e->k, type, e->mask, X);
+      e->X.resize(X.size1(), X.size2());
+      e->X = X;
+
+      pthread_mutex_lock(&mutex);
+      busy = false;
+      e->ready = true;
+      pthread_cond_broadcast(&changed);
+    }
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+template<class IO1>
+typename bi::ReadAhead<IO1>::Entry* bi::ReadAhead<IO1>::find(const int k) {
+  int i;
+  for (i = 0; i < (int)entries.size(); ++i) {
+    if (entries[i]->k == k) {
+      return entries[i];
+    }
+  }
+  return NULL;
+}
+
+template<class IO1>
+void bi::ReadAhead<IO1>::clear() {
+  while (busy) {
+    pthread_cond_wait(&changed, &mutex);
+  }
+  while (!entries.empty()) {
+    delete entries.front();
+    entries.pop_front();
+  }
+}
+
+#endif
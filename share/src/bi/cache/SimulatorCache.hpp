@@ -9,6 +9,7 @@
 #define BI_CACHE_SIMULATORCACHE_HPP
 
 #include "Cache1D.hpp"
+#include "WriteQueue.hpp"
 #include "../buffer/SimulatorNetCDFBuffer.hpp"
 
 namespace bi {
@@ -18,6 +19,10 @@ namespace bi {
  * and contiguous, such that NetCDF/HDF5's own buffering mechanisms, or even
  * direct reads/write on disk, are efficient enough.
  *
+ * Writes of state are copied and handed to writeQueue(), to be performed in
+ * the background. The queue is flushed before any read from, or other write
+ * to, the output buffer, and on flush().
+ *
  * @ingroup io_cache
  *
  * @tparam IO1 Buffer type.
@@ -274,6 +279,7 @@ inline void bi::SimulatorCache<IO1,CL>::readParameters(M1 X) const {
   /* pre-conditions */
   BI_ASSERT(out != NULL);
 
+  writeQueue().flush();
   out->readParameters(X);
 }
 
@@ -281,6 +287,7 @@ template<class IO1, bi::Location CL>
 template<class M1>
 inline void bi::SimulatorCache<IO1,CL>::writeParameters(const M1 X) {
   if (out != NULL) {
+    writeQueue().flush();
     out->writeParameters(X);
   }
 }
@@ -291,6 +298,7 @@ inline void bi::SimulatorCache<IO1,CL>::readState(const int t, M1 X) const {
   /* pre-conditions */
   BI_ASSERT(out != NULL);
 
+  writeQueue().flush();
   out->readState(t, X);
 }
 
@@ -299,7 +307,7 @@ template<class M1>
 inline void bi::SimulatorCache<IO1,CL>::writeState(const int t,
     const M1 X) {
   if (out != NULL) {
-    out->writeState(t, X);
+    writeQueue().push(new StateWriteJob<IO1>(out, t, X));
   }
 }
 
@@ -329,7 +337,9 @@ inline void bi::SimulatorCache<IO1,CL>::empty() {
 template<class IO1, bi::Location CL>
 inline void bi::SimulatorCache<IO1,CL>::flush() {
   if (out != NULL) {
+    writeQueue().flush();
     out->writeTimes(0, getTimes());
+    out->flush();
   }
   timeCache.flush();
 }
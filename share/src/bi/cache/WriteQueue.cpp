@@ -0,0 +1,92 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#include "WriteQueue.hpp"
+
+#include "../misc/assert.hpp"
+
+bi::WriteJob::~WriteJob() {
+  //
+}
+
+bi::WriteQueue::WriteQueue(const int capacity) : capacity(capacity),
+    stopped(false) {
+  /* pre-condition */
+  BI_ASSERT(capacity > 0);
+
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&changed, NULL);
+  BI_ERROR_MSG(pthread_create(&thread, NULL, &WriteQueue::start, this) == 0,
+      "Could not start output thread");
+}
+
+bi::WriteQueue::~WriteQueue() {
+  flush();
+
+  pthread_mutex_lock(&mutex);
+  stopped = true;
+  pthread_cond_broadcast(&changed);
+  pthread_mutex_unlock(&mutex);
+
+  pthread_join(thread, NULL);
+  pthread_cond_destroy(&changed);
+  pthread_mutex_destroy(&mutex);
+}
+
+void bi::WriteQueue::push(WriteJob* job) {
+  pthread_mutex_lock(&mutex);
+  while ((int)jobs.size() >= capacity) {
+    pthread_cond_wait(&changed, &mutex);
+  }
+  jobs.push_back(job);
+  pthread_cond_broadcast(&changed);
+  pthread_mutex_unlock(&mutex);
+}
+
+void bi::WriteQueue::flush() {
+  pthread_mutex_lock(&mutex);
+  while (!jobs.empty()) {
+    pthread_cond_wait(&changed, &mutex);
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+void* bi::WriteQueue::start(void* queue) {
+  static_cast<WriteQueue*>(queue)->run();
+  return NULL;
+}
+
+void bi::WriteQueue::run() {
+  WriteJob* job;
+
+  pthread_mutex_lock(&mutex);
+  while (true) {
+    while (jobs.empty() && !stopped) {
+      pthread_cond_wait(&changed, &mutex);
+    }
+    if (jobs.empty()) {
+      break;
+    }
+
+    /* job stays at front of queue while in progress, so that flush() waits
+     * for it */
+    job = jobs.front();
+    pthread_mutex_unlock(&mutex);
+    job->run();
+    delete job;
+    pthread_mutex_lock(&mutex);
+
+    jobs.pop_front();
+    pthread_cond_broadcast(&changed);
+  }
+  pthread_mutex_unlock(&mutex);
+}
+
+bi::WriteQueue& bi::writeQueue() {
+  static WriteQueue* queue = new WriteQueue();
+  return *queue;
+}
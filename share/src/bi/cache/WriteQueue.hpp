@@ -0,0 +1,266 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_CACHE_WRITEQUEUE_HPP
+#define BI_CACHE_WRITEQUEUE_HPP
+
+#include "../math/matrix.hpp"
+#include "../math/vector.hpp"
+#include "../cuda/cuda.hpp"
+
+#include <deque>
+#include <pthread.h>
+
+namespace bi {
+/**
+ * Write to an output buffer, deferred to WriteQueue.
+ *
+ * @ingroup io_cache
+ */
+class WriteJob {
+public:
+  /**
+   * Destructor.
+   */
+  virtual ~WriteJob();
+
+  /**
+   * Perform the write.
+   */
+  virtual void run() = 0;
+};
+
+/**
+ * Bounded queue of writes to output buffers, performed in order by a
+ * background thread.
+ *
+ * @ingroup io_cache
+ *
+ * Caches hand writes to the queue along with a copy of the data to be
+ * written, and return to computation while the write proceeds. push() blocks
+ * while the queue is full, so that no more than a fixed number of copies are
+ * held at once: with the default capacity of two, one is written while the
+ * next is filled. flush() blocks until all writes have been performed, and
+ * must precede any read of a buffer that may have writes pending, and its
+ * destruction.
+ *
+ * Calls into NetCDF from the background thread and any other are serialised
+ * within the wrappers of netcdf.hpp.
+ */
+class WriteQueue {
+public:
+  /**
+   * Constructor. Starts background thread.
+   *
+   * @param capacity Maximum number of writes queued or in progress.
+   */
+  WriteQueue(const int capacity = 2);
+
+  /**
+   * Destructor. Flushes and stops background thread.
+   */
+  ~WriteQueue();
+
+  /**
+   * Add a write to the back of the queue, blocking while the queue is full.
+   *
+   * @param job The write. The queue takes ownership, and deletes it once
+   * performed.
+   */
+  void push(WriteJob* job);
+
+  /**
+   * Block until all writes have been performed.
+   */
+  void flush();
+
+private:
+  /**
+   * Entry point of background thread.
+   */
+  static void* start(void* queue);
+
+  /**
+   * Perform writes until stopped.
+   */
+  void run();
+
+  /**
+   * Writes queued, the front of which is in progress.
+   */
+  std::deque<WriteJob*> jobs;
+
+  /**
+   * Maximum number of writes queued or in progress.
+   */
+  int capacity;
+
+  /**
+   * Has the background thread been asked to stop?
+   */
+  bool stopped;
+
+  /**
+   * Background thread.
+   */
+  pthread_t thread;
+
+  /**
+   * Mutex guarding the queue.
+   */
+  pthread_mutex_t mutex;
+
+  /**
+   * Signalled whenever the queue changes.
+   */
+  pthread_cond_t changed;
+};
+
+/**
+ * Queue shared by all caches, so that writes are performed in the order in
+ * which they are made. It is created on first use, from the main thread, and
+ * never destroyed, so that an exit on error does not wait on its background
+ * thread; caches flush it on their own destruction instead.
+ *
+ * @ingroup io_cache
+ */
+WriteQueue& writeQueue();
+
+/**
+ * Deferred write of state.
+ *
+ * @ingroup io_cache
+ *
+ * @tparam IO1 Buffer type.
+ */
+template<class IO1>
+class StateWriteJob: public WriteJob {
+public:
+  /**
+   * Constructor.
+   *
+   * @tparam M1 Matrix type.
+   *
+   * @param out Output buffer.
+   * @param k Time index.
+   * @param X State, copied.
+   */
+  template<class M1>
+  StateWriteJob(IO1* out, const int k, const M1 X);
+
+  virtual void run();
+
+private:
+  IO1* out;
+  int k;
+  host_matrix<real> X;
+};
+
+/**
+ * Deferred write of log-weights.
+ *
+ * @ingroup io_cache
+ *
+ * @tparam IO1 Buffer type.
+ */
+template<class IO1>
+class LogWeightsWriteJob: public WriteJob {
+public:
+  /**
+   * Constructor.
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param out Output buffer.
+   * @param k Time index.
+   * @param lws Log-weights, copied.
+   */
+  template<class V1>
+  LogWeightsWriteJob(IO1* out, const int k, const V1 lws);
+
+  virtual void run();
+
+private:
+  IO1* out;
+  int k;
+  host_vector<real> lws;
+};
+
+/**
+ * Deferred write of ancestors.
+ *
+ * @ingroup io_cache
+ *
+ * @tparam IO1 Buffer type.
+ */
+template<class IO1>
+class AncestorsWriteJob: public WriteJob {
+public:
+  /**
+   * Constructor.
+   *
+   * @tparam V1 Integral vector type.
+   *
+   * @param out Output buffer.
+   * @param k Time index.
+   * @param as Ancestors, copied.
+   */
+  template<class V1>
+  AncestorsWriteJob(IO1* out, const int k, const V1 as);
+
+  virtual void run();
+
+private:
+  IO1* out;
+  int k;
+  host_vector<int> as;
+};
+}
+
+template<class IO1>
+template<class M1>
+bi::StateWriteJob<IO1>::StateWriteJob(IO1* out, const int k, const M1 X) :
+    out(out), k(k), X(X.size1(), X.size2()) {
+  /* deep copy, as construction from a host matrix would be shallow */
+  this->X = X;
+  synchronize(M1::on_device);
+}
+
+template<class IO1>
+void bi::StateWriteJob<IO1>::run() {
+  out->writeState(k, X);
+}
+
+template<class IO1>
+template<class V1>
+bi::LogWeightsWriteJob<IO1>::LogWeightsWriteJob(IO1* out, const int k,
+    const V1 lws) :
+    out(out), k(k), lws(lws.size()) {
+  this->lws = lws;
+  synchronize(V1::on_device);
+}
+
+template<class IO1>
+void bi::LogWeightsWriteJob<IO1>::run() {
+  out->writeLogWeights(k, lws);
+}
+
+template<class IO1>
+template<class V1>
+bi::AncestorsWriteJob<IO1>::AncestorsWriteJob(IO1* out, const int k,
+    const V1 as) :
+    out(out), k(k), as(as.size()) {
+  this->as = as;
+  synchronize(V1::on_device);
+}
+
+template<class IO1>
+void bi::AncestorsWriteJob<IO1>::run() {
+  out->writeAncestors(k, as);
+}
+
+#endif
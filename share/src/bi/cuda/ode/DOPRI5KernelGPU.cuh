@@ -75,6 +75,7 @@ CUDA_FUNC_GLOBAL void bi::kernelDOPRI5(const T1 t1, const T1 t2, State<B,ON_DEVI
 
   /* integrate */
   real x0, x1, x2, x3, x4, x5, x6, err;
+  real dense; // continuous extension, unused on device
   real k1, k7;
 
   int n = 0;
@@ -87,7 +88,7 @@ CUDA_FUNC_GLOBAL void bi::kernelDOPRI5(const T1 t1, const T1 t2, State<B,ON_DEVI
     __syncthreads();
 
     /* stages */
-    Visitor::stage1(t, h, s, p, i, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, k1in);
+    Visitor::stage1(t, h, s, p, i, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, dense, k1in);
     k1in = true; // can reuse from previous iteration in future
     __syncthreads();
     x = x1;
@@ -98,28 +99,28 @@ CUDA_FUNC_GLOBAL void bi::kernelDOPRI5(const T1 t1, const T1 t2, State<B,ON_DEVI
     x = x2;
     __syncthreads();
 
-    Visitor::stage3(t, h, s, p, i, pax, x0, x3, x4, x5, x6, err);
+    Visitor::stage3(t, h, s, p, i, pax, x0, x3, x4, x5, x6, err, dense);
     __syncthreads();
     x = x3;
     __syncthreads();
 
-    Visitor::stage4(t, h, s, p, i, pax, x0, x4, x5, x6, err);
+    Visitor::stage4(t, h, s, p, i, pax, x0, x4, x5, x6, err, dense);
     __syncthreads();
     x = x4;
     __syncthreads();
 
-    Visitor::stage5(t, h, s, p, i, pax, x0, x5, x6, err);
+    Visitor::stage5(t, h, s, p, i, pax, x0, x5, x6, err, dense);
     __syncthreads();
     x = x5;
     __syncthreads();
 
-    Visitor::stage6(t, h, s, p, i, pax, x0, x6, err);
+    Visitor::stage6(t, h, s, p, i, pax, x0, x6, err, dense);
     __syncthreads();
     x = x6;
     __syncthreads();
 
     /* compute error */
-    Visitor::stageErr(t, h, s, p, i, pax, x0, x6, k7, err);
+    Visitor::stageErr(t, h, s, p, i, pax, x0, x6, k7, err, dense);
     err *= h;
     err /= atoler + rtoler*bi::max(bi::abs(x0), bi::abs(x6));
 
@@ -24,12 +24,12 @@ namespace bi {
 template<class B, class S1, class S2, class T1, class PX, class T2>
 class DOPRI5VisitorGPU {
 public:
-  static CUDA_FUNC_DEVICE void stage1(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, const bool k1in = false) {
+  static CUDA_FUNC_DEVICE void stage1(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, T2& dense, const bool k1in = false) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stage1(t, h, s, p, cox, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, k1in);
+      stage::stage1(t, h, s, p, cox, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, dense, k1in);
     } else {
-      visitor::stage1(t, h, s, p, i, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, k1in);
+      visitor::stage1(t, h, s, p, i, pax, x0, x1, x2, x3, x4, x5, x6, k1, err, dense, k1in);
     }
   }
 
@@ -42,48 +42,48 @@ public:
     }
   }
 
-  static CUDA_FUNC_DEVICE void stage3(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage3(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stage3(t, h, s, p, cox, pax, x0, x3, x4, x5, x6, err);
+      stage::stage3(t, h, s, p, cox, pax, x0, x3, x4, x5, x6, err, dense);
     } else {
-      visitor::stage3(t, h, s, p, i, pax, x0, x3, x4, x5, x6, err);
+      visitor::stage3(t, h, s, p, i, pax, x0, x3, x4, x5, x6, err, dense);
     }
   }
 
-  static CUDA_FUNC_DEVICE void stage4(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage4(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stage4(t, h, s, p, cox, pax, x0, x4, x5, x6, err);
+      stage::stage4(t, h, s, p, cox, pax, x0, x4, x5, x6, err, dense);
     } else {
-      visitor::stage4(t, h, s, p, i, pax, x0, x4, x5, x6, err);
+      visitor::stage4(t, h, s, p, i, pax, x0, x4, x5, x6, err, dense);
     }
   }
 
-  static CUDA_FUNC_DEVICE void stage5(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage5(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x5, T2& x6, T2& err, T2& dense) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stage5(t, h, s, p, cox, pax, x0, x5, x6, err);
+      stage::stage5(t, h, s, p, cox, pax, x0, x5, x6, err, dense);
     } else {
-      visitor::stage5(t, h, s, p, i, pax, x0, x5, x6, err);
+      visitor::stage5(t, h, s, p, i, pax, x0, x5, x6, err, dense);
     }
   }
 
-  static CUDA_FUNC_DEVICE void stage6(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage6(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x6, T2& err, T2& dense) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stage6(t, h, s, p, cox, pax, x0, x6, err);
+      stage::stage6(t, h, s, p, cox, pax, x0, x6, err, dense);
     } else {
-      visitor::stage6(t, h, s, p, i, pax, x0, x6, err);
+      visitor::stage6(t, h, s, p, i, pax, x0, x6, err, dense);
     }
   }
 
-  static CUDA_FUNC_DEVICE void stageErr(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, const T2& x1, T2& k7, T2& err) {
+  static CUDA_FUNC_DEVICE void stageErr(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, const T2& x1, T2& k7, T2& err, T2& dense) {
     if (i < end) {
       coord_type cox(i - start);
-      stage::stageErr(t, h, s, p, cox, pax, x0, x1, k7, err);
+      stage::stageErr(t, h, s, p, cox, pax, x0, x1, k7, err, dense);
     } else {
-      visitor::stageErr(t, h, s, p, i, pax, x0, x1, k7, err);
+      visitor::stageErr(t, h, s, p, i, pax, x0, x1, k7, err, dense);
     }
   }
 
@@ -108,7 +108,7 @@ private:
 template<class B, class S1, class T1, class PX, class T2>
 class DOPRI5VisitorGPU<B,S1,empty_typelist,T1,PX,T2> {
 public:
-  static CUDA_FUNC_DEVICE void stage1(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, const bool k1in = false) {
+  static CUDA_FUNC_DEVICE void stage1(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, T2& dense, const bool k1in = false) {
     //
   }
 
@@ -116,23 +116,23 @@ public:
     //
   }
 
-  static CUDA_FUNC_DEVICE void stage3(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage3(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     //
   }
 
-  static CUDA_FUNC_DEVICE void stage4(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage4(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     //
   }
 
-  static CUDA_FUNC_DEVICE void stage5(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage5(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x5, T2& x6, T2& err, T2& dense) {
     //
   }
 
-  static CUDA_FUNC_DEVICE void stage6(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x6, T2& err) {
+  static CUDA_FUNC_DEVICE void stage6(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, T2& x6, T2& err, T2& dense) {
     //
   }
 
-  static CUDA_FUNC_DEVICE void stageErr(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, const T2& x1, T2& k7, T2& err) {
+  static CUDA_FUNC_DEVICE void stageErr(const T1 t, const T1 h, const State<B,ON_DEVICE>& s, const int p, const int i, const PX& pax, const T2& x0, const T2& x1, T2& k7, T2& err, T2& dense) {
     //
   }
 };
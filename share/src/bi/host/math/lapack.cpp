@@ -13,3 +13,5 @@
 
 LAPACK_FUNC_DEF(potrf, dpotrf, spotrf)
 LAPACK_FUNC_DEF(potrs, dpotrs, spotrs)
+LAPACK_FUNC_DEF(getrf, dgetrf, sgetrf)
+LAPACK_FUNC_DEF(getrs, dgetrs, sgetrs)
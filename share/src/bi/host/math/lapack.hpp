@@ -17,6 +17,12 @@ extern "C" {
       int* ldb, int* info);
   void dpotrs_(char* uplo, int* n, int* nhrs, double* A, int* lda, double* B,
       int* ldb, int* info);
+  void sgetrf_(int* m, int* n, float* A, int* lda, int* ipiv, int* info);
+  void dgetrf_(int* m, int* n, double* A, int* lda, int* ipiv, int* info);
+  void sgetrs_(char* trans, int* n, int* nrhs, float* A, int* lda, int* ipiv,
+      float* B, int* ldb, int* info);
+  void dgetrs_(char* trans, int* n, int* nrhs, double* A, int* lda, int* ipiv,
+      double* B, int* ldb, int* info);
 }
 
 #include "boost/typeof/typeof.hpp"
@@ -44,5 +50,7 @@ namespace bi { \
 
 LAPACK_FUNC(potrf, dpotrf, spotrf)
 LAPACK_FUNC(potrs, dpotrs, spotrs)
+LAPACK_FUNC(getrf, dgetrf, sgetrf)
+LAPACK_FUNC(getrs, dgetrs, sgetrs)
 
 #endif
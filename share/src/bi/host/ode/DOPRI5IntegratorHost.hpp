@@ -8,6 +8,8 @@
 #ifndef BI_HOST_ODE_DOPRI5INTEGRATORHOST_HPP
 #define BI_HOST_ODE_DOPRI5INTEGRATORHOST_HPP
 
+#include "IntegratorState.hpp"
+
 namespace bi {
 /**
  * Dormand-Prince 5(4) integrator.
@@ -17,6 +19,18 @@ namespace bi {
  * @tparam B Model type.
  * @tparam S Action type list.
  * @tparam T1 Scalar type.
+ *
+ * The step size of each trajectory is kept between calls (see
+ * IntegratorState), so that integration does not restart from the initial
+ * step size at the start of each time interval.
+ *
+ * Where the state indicates that trajectories are continuous past the end
+ * of the time interval (see State::isContinuous()), the last step is not
+ * truncated to end on the interval. It may step past, with the state at
+ * the end of the interval given by the continuous extension of @ref
+ * Hairer1993 "Hairer, Norsett & Wanner (1993)", and the step is kept to
+ * be carried into the next interval. Intervals that end at output times
+ * only can so be passed through without restarting.
  */
 template<class B, class S, class T1>
 class DOPRI5IntegratorHost {
@@ -29,11 +43,26 @@ public:
    * @param[in,out] s State.
    */
   static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
+
+private:
+  /**
+   * Columns of integrator state of each trajectory, after those of
+   * IntegratorState: the time from which a step is carried, the start and
+   * size of that step, and the five coefficients of its continuous
+   * extension for each variable.
+   */
+  enum {
+    TB = IntegratorState<B,S>::SIZE,
+    TOLD,
+    HOLD,
+    RCONT
+  };
 };
 }
 
 #include "DOPRI5VisitorHost.hpp"
 #include "IntegratorConstants.hpp"
+#include "IntegratorDiagnostics.hpp"
 #include "../host.hpp"
 #include "../../state/Pa.hpp"
 #include "../../typelist/front.hpp"
@@ -41,6 +70,8 @@ public:
 #include "../../traits/block_traits.hpp"
 #include "../../math/view.hpp"
 
+#include "boost/typeof/typeof.hpp"
+
 template<class B, class S, class T1>
 void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
@@ -50,13 +81,22 @@ void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
   typedef host_vector_reference<real> vector_reference_type;
   typedef Pa<ON_HOST,B,host,host,host,host> PX;
   typedef DOPRI5VisitorHost<B,S,S,real,PX,real> Visitor;
+  typedef IntegratorState<B,S> Persist;
 
   static const int N = block_size<S>::value;
   const int P = s.size();
+  const bool continuous = s.isContinuous();
+
+  Persist::init(s, RCONT + 5*N);
+  BOOST_AUTO(O, s.getOde());
+
+  #ifdef ENABLE_DIAGNOSTICS
+  IntegratorDiagnostics diagnostics("DOPRI5IntegratorHost");
+  #endif
 
   #pragma omp parallel
   {
-    real buf[10*N]; // use of dynamic array faster than heap allocation
+    real buf[16*N]; // use of dynamic array faster than heap allocation
     vector_reference_type x0(buf, N);
     vector_reference_type x1(buf + N, N);
     vector_reference_type x2(buf + 2*N, N);
@@ -67,27 +107,50 @@ void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
     vector_reference_type err(buf + 7*N, N);
     vector_reference_type k1(buf + 8*N, N);
     vector_reference_type k7(buf + 9*N, N);
+    vector_reference_type dense(buf + 10*N, N);
+    vector_reference_type rcont(buf + 11*N, 5*N);
 
-    real t, h, e, e2, logfacold, logfac11, fac;
+    real t, h, hprop, e, e2, logfacold, logfac11, fac, told, hold, theta, theta1;
     int n, id, p;
-    bool k1in;
+    bool k1in, truncated;
     PX pax;
+    #ifdef ENABLE_DIAGNOSTICS
+    long steps = 0;
+    #endif
 
-    #pragma omp for
+    #pragma omp for schedule(dynamic, BI_ODE_CHUNK_SIZE) nowait
     for (p = 0; p < P; ++p) {
-      t = t1;
-      h = h_h0;
-      logfacold = bi::log(BI_REAL(1.0e-4));
+      BOOST_AUTO(o, row(O, p));
+
+      Persist::load(o, h, logfacold);
+      if (Persist::owns(o) && o(HOLD) > BI_REAL(0.0) && o(TB) == t1) {
+        /* resume from step carried from previous interval */
+        told = o(TOLD);
+        hold = o(HOLD);
+        rcont = subrange(o, RCONT, 5*N);
+        t = told + hold;
+        for (id = 0; id < N; ++id) {
+          x0(id) = rcont(id) + rcont(N + id);
+        }
+        host_store<B,S>(s, p, x0);
+      } else {
+        told = t1;
+        hold = BI_REAL(0.0);
+        t = t1;
+        host_load<B,S>(s, p, x0);
+      }
       k1in = false;
+      truncated = false;
       n = 0;
-      host_load<B,S>(s, p, x0);
 
       /* integrate */
       while (t < t2 && n < h_nsteps) {
         if (BI_REAL(0.1)*bi::abs(h) <= bi::abs(t)*h_uround) {
           // step size too small
         }
-        if (t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0)) {
+        truncated = !continuous && t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0);
+        if (truncated) {
+          hprop = h;
           h = t2 - t;
           if (h <= BI_REAL(0.0)) {
             t = t2;
@@ -96,26 +159,26 @@ void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
         }
 
         /* stages */
-        Visitor::stage1(t, h, s, p, pax, x0.buf(), x1.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), k1.buf(), err.buf(), k1in);
+        Visitor::stage1(t, h, s, p, pax, x0.buf(), x1.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), k1.buf(), err.buf(), dense.buf(), k1in);
         k1in = true; // can reuse from previous iteration in future
         host_store<B,S>(s, p, x1);
 
         Visitor::stage2(t, h, s, p, pax, x0.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
         host_store<B,S>(s, p, x2);
 
-        Visitor::stage3(t, h, s, p, pax, x0.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
+        Visitor::stage3(t, h, s, p, pax, x0.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
         host_store<B,S>(s, p, x3);
 
-        Visitor::stage4(t, h, s, p, pax, x0.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
+        Visitor::stage4(t, h, s, p, pax, x0.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
         host_store<B,S>(s, p, x4);
 
-        Visitor::stage5(t, h, s, p, pax, x0.buf(), x5.buf(), x6.buf(), err.buf());
+        Visitor::stage5(t, h, s, p, pax, x0.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
         host_store<B,S>(s, p, x5);
 
-        Visitor::stage6(t, h, s, p, pax, x0.buf(), x6.buf(), err.buf());
+        Visitor::stage6(t, h, s, p, pax, x0.buf(), x6.buf(), err.buf(), dense.buf());
 
         /* compute error */
-        Visitor::stageErr(t, h, s, p, pax, x0.buf(), x6.buf(), k7.buf(), err.buf());
+        Visitor::stageErr(t, h, s, p, pax, x0.buf(), x6.buf(), k7.buf(), err.buf(), dense.buf());
         e2 = 0.0;
         for (id = 0; id < N; ++id) {
           e = err(id)*h/(h_atoler + h_rtoler*bi::max(bi::abs(x0(id)), bi::abs(x6(id))));
@@ -126,6 +189,18 @@ void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
         /* accept/reject */
         if (e2 <= BI_REAL(1.0)) {
           /* accept */
+          if (t + h > t2) {
+            /* continuous extension, for end of interval */
+            for (id = 0; id < N; ++id) {
+              rcont(id) = x0(id);
+              rcont(N + id) = x6(id) - x0(id);
+              rcont(2*N + id) = h*k1(id) - rcont(N + id);
+              rcont(3*N + id) = rcont(N + id) - h*k7(id) - rcont(2*N + id);
+              rcont(4*N + id) = h*dense(id);
+            }
+            told = t;
+            hold = h;
+          }
           t += h;
           x0.swap(x6);
           k1.swap(k7);
@@ -133,23 +208,50 @@ void bi::DOPRI5IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
         host_store<B,S>(s, p, x0);
 
         /* compute next step size */
-        if (t < t2) {
-          logfac11 = h_expo*bi::log(e2);
-          if (e2 > BI_REAL(1.0)) {
-            /* step was rejected */
-            h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
-          } else {
-            /* step was accepted */
-            fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
-            fac = bi::min(h_facr, bi::max(h_facl, fac));  // bound
-            h *= fac;
-            logfacold = BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8)));
-          }
+        logfac11 = h_expo*bi::log(e2);
+        if (e2 > BI_REAL(1.0)) {
+          /* step was rejected */
+          h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
+        } else {
+          /* step was accepted */
+          fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
+          fac = bi::min(h_facr, bi::max(h_facl, fac));  // bound
+          h *= fac;
+          logfacold = BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8)));
         }
 
         ++n;
       }
+
+      if (t > t2) {
+        /* stepped past end of interval, interpolate */
+        theta = (t2 - told)/hold;
+        theta1 = BI_REAL(1.0) - theta;
+        for (id = 0; id < N; ++id) {
+          x1(id) = rcont(id) + theta*(rcont(N + id) + theta1*(rcont(2*N + id)
+              + theta*(rcont(3*N + id) + theta1*rcont(4*N + id))));
+        }
+        host_store<B,S>(s, p, x1);
+      }
+
+      /* keep step size, and step to carry if continuous */
+      Persist::store(o, (truncated && t >= t2) ? bi::max(h, hprop) : h,
+          logfacold);
+      if (continuous && t > t2) {
+        o(TB) = t2;
+        o(TOLD) = told;
+        o(HOLD) = hold;
+        subrange(o, RCONT, 5*N) = rcont;
+      }
+
+      #ifdef ENABLE_DIAGNOSTICS
+      steps += n;
+      #endif
     }
+
+    #ifdef ENABLE_DIAGNOSTICS
+    diagnostics.record(steps);
+    #endif
   }
 }
 
@@ -26,18 +26,19 @@ class DOPRI5VisitorHost {
 public:
   static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x1, T2* x2, T2* x3,
-      T2* x4, T2* x5, T2* x6, T2* k1, T2* err, const bool k1in = false) {
+      T2* x4, T2* x5, T2* x6, T2* k1, T2* err, T2* dense,
+      const bool k1in = false) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
       stage::stage1(t, h, s, p, cox, pax, x0[id], x1[id], x2[id], x3[id],
-          x4[id], x5[id], x6[id], k1[id], err[id], k1in);
+          x4[id], x5[id], x6[id], k1[id], err[id], dense[id], k1in);
       ++cox;
       ++id;
     }
     visitor::stage1(t, h, s, p, pax, x0, x1, x2, x3, x4, x5, x6, k1, err,
-        k1in);
+        dense, k1in);
   }
 
   static void stage2(const T1 t, const T1 h, const State<B,ON_HOST>& s,
@@ -57,72 +58,75 @@ public:
 
   static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x3, T2* x4, T2* x5,
-      T2* x6, T2* err) {
+      T2* x6, T2* err, T2* dense) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
       stage::stage3(t, h, s, p, cox, pax, x0[id], x3[id], x4[id], x5[id],
-          x6[id], err[id]);
+          x6[id], err[id], dense[id]);
       ++cox;
       ++id;
     }
-    visitor::stage3(t, h, s, p, pax, x0, x3, x4, x5, x6, err);
+    visitor::stage3(t, h, s, p, pax, x0, x3, x4, x5, x6, err, dense);
   }
 
   static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x4, T2* x5, T2* x6,
-      T2* err) {
+      T2* err, T2* dense) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
       stage::stage4(t, h, s, p, cox, pax, x0[id], x4[id], x5[id], x6[id],
-          err[id]);
+          err[id], dense[id]);
       ++cox;
       ++id;
     }
-    visitor::stage4(t, h, s, p, pax, x0, x4, x5, x6, err);
+    visitor::stage4(t, h, s, p, pax, x0, x4, x5, x6, err, dense);
   }
 
   static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
-      const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err) {
+      const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err,
+      T2* dense) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
-      stage::stage5(t, h, s, p, cox, pax, x0[id], x5[id], x6[id], err[id]);
+      stage::stage5(t, h, s, p, cox, pax, x0[id], x5[id], x6[id], err[id],
+          dense[id]);
       ++cox;
       ++id;
     }
-    visitor::stage5(t, h, s, p, pax, x0, x5, x6, err);
+    visitor::stage5(t, h, s, p, pax, x0, x5, x6, err, dense);
   }
 
   static void stage6(const T1 t, const T1 h, const State<B,ON_HOST>& s,
-      const int p, const PX& pax, const T2* x0, T2* x6, T2* err) {
+      const int p, const PX& pax, const T2* x0, T2* x6, T2* err, T2* dense) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
-      stage::stage6(t, h, s, p, cox, pax, x0[id], x6[id], err[id]);
+      stage::stage6(t, h, s, p, cox, pax, x0[id], x6[id], err[id], dense[id]);
       ++cox;
       ++id;
     }
-    visitor::stage6(t, h, s, p, pax, x0, x6, err);
+    visitor::stage6(t, h, s, p, pax, x0, x6, err, dense);
   }
 
   static void stageErr(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, const T2* x1, T2* k7,
-      T2* err) {
+      T2* err, T2* dense) {
     coord_type cox;
     int id = start;
 
     while (id < end) {
-      stage::stageErr(t, h, s, p, cox, pax, x0[id], x1[id], k7[id], err[id]);
+      stage::stageErr(t, h, s, p, cox, pax, x0[id], x1[id], k7[id], err[id],
+          dense[id]);
       ++cox;
       ++id;
     }
-    visitor::stageErr(t, h, s, p, pax, x0, x1, k7, err);
+    visitor::stageErr(t, h, s, p, pax, x0, x1, k7, err, dense);
   }
 
 private:
@@ -147,7 +151,8 @@ class DOPRI5VisitorHost<B,S1,empty_typelist,T1,PX,T2> {
 public:
   static void stage1(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x1, T2* x2, T2* x3,
-      T2* x4, T2* x5, T2* x6, T2* k1, T2* err, const bool k1in = false) {
+      T2* x4, T2* x5, T2* x6, T2* k1, T2* err, T2* dense,
+      const bool k1in = false) {
     //
   }
 
@@ -159,29 +164,30 @@ public:
 
   static void stage3(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x3, T2* x4, T2* x5,
-      T2* x6, T2* err) {
+      T2* x6, T2* err, T2* dense) {
     //
   }
 
   static void stage4(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, T2* x4, T2* x5, T2* x6,
-      T2* err) {
+      T2* err, T2* dense) {
     //
   }
 
   static void stage5(const T1 t, const T1 h, const State<B,ON_HOST>& s,
-      const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err) {
+      const int p, const PX& pax, const T2* x0, T2* x5, T2* x6, T2* err,
+      T2* dense) {
     //
   }
 
   static void stage6(const T1 t, const T1 h, const State<B,ON_HOST>& s,
-      const int p, const PX& pax, const T2* x0, T2* x6, T2* err) {
+      const int p, const PX& pax, const T2* x0, T2* x6, T2* err, T2* dense) {
     //
   }
 
   static void stageErr(const T1 t, const T1 h, const State<B,ON_HOST>& s,
       const int p, const PX& pax, const T2* x0, const T2* x1, T2* k7,
-      T2* err) {
+      T2* err, T2* dense) {
     //
   }
 };
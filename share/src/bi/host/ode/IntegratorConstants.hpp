@@ -12,6 +12,17 @@
 
 #include "../../math/scalar.hpp"
 
+/**
+ * @def BI_ODE_CHUNK_SIZE
+ *
+ * Number of loop iterations in each chunk of particles scheduled
+ * dynamically across threads by adaptive ODE integrators on host. Small
+ * chunks balance load when the number of steps varies between particles.
+ * Also the number of particles in each tile, for those integrators that
+ * copy particles into tiles.
+ */
+#define BI_ODE_CHUNK_SIZE 4
+
 /**
  * @internal
  *
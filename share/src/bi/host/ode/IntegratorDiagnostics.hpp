@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_ODE_INTEGRATORDIAGNOSTICS_HPP
+#define BI_HOST_ODE_INTEGRATORDIAGNOSTICS_HPP
+
+#include "../../misc/TicToc.hpp"
+#include "../../misc/omp.hpp"
+
+#include <vector>
+
+namespace bi {
+/**
+ * Load balance diagnostics for adaptive ODE integrators on host.
+ *
+ * @ingroup method_updater
+ *
+ * Records, for each thread, the number of steps taken and the time spent
+ * integrating over a single call to an integrator, and reports these, with
+ * the total number of steps, on destruction. The ratio of the maximum to
+ * the mean time across threads measures the imbalance; the remainder of
+ * the maximum is time that other threads spend idle at the end of the
+ * parallel region.
+ */
+class IntegratorDiagnostics {
+public:
+  /**
+   * Constructor. Starts timer.
+   *
+   * @param name Name of integrator, for report.
+   */
+  IntegratorDiagnostics(const char* name);
+
+  /**
+   * Destructor. Reports.
+   */
+  ~IntegratorDiagnostics();
+
+  /**
+   * Record result for the calling thread. Call once from each thread, once
+   * it has finished integrating.
+   *
+   * @param steps Number of steps taken by the calling thread.
+   */
+  void record(const long steps);
+
+  /**
+   * Report to standard error.
+   */
+  void report() const;
+
+private:
+  /**
+   * Name of integrator.
+   */
+  const char* name;
+
+  /**
+   * Timer.
+   */
+  TicToc clock;
+
+  /**
+   * Number of steps taken by each thread.
+   */
+  std::vector<long> steps;
+
+  /**
+   * Time spent integrating by each thread.
+   */
+  std::vector<long> usecs;
+};
+}
+
+#include <iostream>
+#include <algorithm>
+
+inline bi::IntegratorDiagnostics::IntegratorDiagnostics(const char* name) :
+    name(name), steps(bi_omp_max_threads, 0), usecs(bi_omp_max_threads, 0) {
+  //
+}
+
+inline bi::IntegratorDiagnostics::~IntegratorDiagnostics() {
+  report();
+}
+
+inline void bi::IntegratorDiagnostics::record(const long steps) {
+  this->steps[bi_omp_tid] = steps;
+  this->usecs[bi_omp_tid] = clock.toc();
+}
+
+inline void bi::IntegratorDiagnostics::report() const {
+  long total = 0, max = 0, nsteps = 0;
+  int i;
+
+  std::cerr << name << ":";
+  for (i = 0; i < (int)steps.size(); ++i) {
+    std::cerr << " thread " << i << " " << steps[i] << " steps " << usecs[i]
+        << " us,";
+    total += usecs[i];
+    max = std::max(max, usecs[i]);
+    nsteps += steps[i];
+  }
+  std::cerr << " total " << nsteps << " steps,";
+  if (total > 0) {
+    std::cerr << " imbalance " << max*steps.size()/static_cast<double>(total);
+  }
+  std::cerr << std::endl;
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_ODE_INTEGRATORSTATE_HPP
+#define BI_HOST_ODE_INTEGRATORSTATE_HPP
+
+#include "../../state/State.hpp"
+#include "../../typelist/front.hpp"
+
+namespace bi {
+/**
+ * Step-size control state of adaptive ODE integrators on host, kept for
+ * each trajectory between calls.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ *
+ * Each row of State::getOde() begins with the type and index of the first
+ * target of the block that last wrote it, followed by the step size and
+ * Lund-stabilization term at the end of its last call. Only the same block
+ * restores these; any other starts from the initial step size, so that
+ * blocks sharing the buffer never adopt one another's step size.
+ * Integrators may keep further state in columns from #SIZE onwards,
+ * written after store().
+ */
+template<class B, class S>
+class IntegratorState {
+public:
+  /**
+   * Columns.
+   */
+  enum {
+    KEY_TYPE,
+    KEY_INDEX,
+    H,
+    LOGFACOLD,
+    SIZE
+  };
+
+  /**
+   * Prepare buffer of state. Call outside of any parallel region.
+   *
+   * @param[in,out] s State.
+   * @param N Number of columns required by integrator, at least #SIZE.
+   */
+  static void init(State<B,ON_HOST>& s, const int N = SIZE);
+
+  /**
+   * Was state written by this block?
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param o Row of state.
+   */
+  template<class V1>
+  static bool owns(const V1 o);
+
+  /**
+   * Restore step size, or initialise it if not written by this block.
+   *
+   * @tparam V1 Vector type.
+   * @tparam T1 Scalar type.
+   *
+   * @param o Row of state.
+   * @param[out] h Step size.
+   * @param[out] logfacold Lund-stabilization term.
+   */
+  template<class V1, class T1>
+  static void load(const V1 o, T1& h, T1& logfacold);
+
+  /**
+   * Keep step size. Any further columns, which hold state particular to
+   * the integrator that last wrote them, are cleared.
+   *
+   * @tparam V1 Vector type.
+   * @tparam T1 Scalar type.
+   *
+   * @param[out] o Row of state.
+   * @param h Step size.
+   * @param logfacold Lund-stabilization term.
+   */
+  template<class V1, class T1>
+  static void store(V1 o, const T1 h, const T1 logfacold);
+
+private:
+  typedef typename front<S>::type::target_type key_type;
+  typedef typename front<S>::type::coord_type key_coord_type;
+
+  /**
+   * Type of first target of block.
+   */
+  static real keyType();
+
+  /**
+   * Serial index of first target of block, among variables of its type.
+   */
+  static real keyIndex();
+};
+}
+
+#include "IntegratorConstants.hpp"
+#include "../../traits/var_traits.hpp"
+#include "../../math/view.hpp"
+
+template<class B, class S>
+inline void bi::IntegratorState<B,S>::init(State<B,ON_HOST>& s,
+    const int N) {
+  /* pre-condition */
+  BI_ASSERT(N >= SIZE);
+
+  s.resizeOde(N);
+}
+
+template<class B, class S>
+template<class V1>
+inline bool bi::IntegratorState<B,S>::owns(const V1 o) {
+  return o(KEY_TYPE) == keyType() && o(KEY_INDEX) == keyIndex();
+}
+
+template<class B, class S>
+template<class V1, class T1>
+inline void bi::IntegratorState<B,S>::load(const V1 o, T1& h,
+    T1& logfacold) {
+  if (owns(o) && o(H) > BI_REAL(0.0)) {
+    h = o(H);
+    logfacold = o(LOGFACOLD);
+  } else {
+    h = h_h0;
+    logfacold = bi::log(BI_REAL(1.0e-4));
+  }
+}
+
+template<class B, class S>
+template<class V1, class T1>
+inline void bi::IntegratorState<B,S>::store(V1 o, const T1 h,
+    const T1 logfacold) {
+  o(KEY_TYPE) = keyType();
+  o(KEY_INDEX) = keyIndex();
+  o(H) = h;
+  o(LOGFACOLD) = logfacold;
+  if (o.size() > SIZE) {
+    subrange(o, SIZE, o.size() - SIZE).clear();
+  }
+}
+
+template<class B, class S>
+inline real bi::IntegratorState<B,S>::keyType() {
+  return var_type<key_type>::value;
+}
+
+template<class B, class S>
+inline real bi::IntegratorState<B,S>::keyIndex() {
+  return var_start<key_type>::value + key_coord_type().index();
+}
+
+#endif
@@ -21,6 +21,19 @@ namespace bi {
  * Implements the RK4(3)5[2R+]C method as described in @ref Kennedy2000
  * "Kennedy et. al. (2000)". Implementation described in @ref Murray2011
  * "Murray (2011)".
+ *
+ * The step size of each trajectory is kept between calls (see
+ * IntegratorState).
+ *
+ * Trajectories are integrated in tiles of #BI_ODE_CHUNK_SIZE, each copied
+ * into a small state local to the thread, so that the loads and stores of
+ * each stage are to a contiguous block that stays in cache, rather than
+ * strided across the whole state. Each tile is written back once, when all
+ * of its trajectories have been integrated.
+ *
+ * RK43Integrator dispatches to RK43IntegratorAVX or RK43IntegratorSSE
+ * when built with <tt>ENABLE_AVX</tt> or <tt>ENABLE_SSE</tt>, so this
+ * integrator, and its tiling, is only used by builds without either.
  */
 template<class B, class S, class T1>
 class RK43IntegratorHost {
@@ -38,6 +51,8 @@ public:
 
 #include "RK43VisitorHost.hpp"
 #include "IntegratorConstants.hpp"
+#include "IntegratorDiagnostics.hpp"
+#include "IntegratorState.hpp"
 #include "../host.hpp"
 #include "../../state/Pa.hpp"
 #include "../../typelist/front.hpp"
@@ -46,6 +61,8 @@ public:
 #include "../../math/view.hpp"
 #include "../../math/temp_vector.hpp"
 
+#include "boost/typeof/typeof.hpp"
+
 template<class B, class S, class T1>
 void bi::RK43IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
@@ -55,98 +72,137 @@ void bi::RK43IntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
   typedef host_vector_reference<real> vector_reference_type;
   typedef Pa<ON_HOST,B,host,host,host,host> PX;
   typedef RK43VisitorHost<B,S,S,real,PX,real> Visitor;
+  typedef IntegratorState<B,S> Persist;
 
   static const int N = block_size<S>::value;
   const int P = s.size();
 
+  Persist::init(s);
+  BOOST_AUTO(O, s.getOde());
+
+  #ifdef ENABLE_DIAGNOSTICS
+  IntegratorDiagnostics diagnostics("RK43IntegratorHost");
+  #endif
+
   #pragma omp parallel
   {
+    State<B,ON_HOST> x(BI_ODE_CHUNK_SIZE); // tile of trajectories
     real buf[4*N]; // use of dynamic array faster than heap allocation
     vector_reference_type r1(buf, N);
     vector_reference_type r2(buf + N, N);
     vector_reference_type err(buf + 2*N, N);
     vector_reference_type old(buf + 3*N, N);
 
-    real t, h, e, e2, logfacold, logfac11, fac;
-    int n, id, p;
+    real t, h, hprop, e, e2, logfacold, logfac11, fac;
+    int n, id, p, p1, P1, q;
+    bool truncated;
     PX pax;
-
-    #pragma omp for
-    for (p = 0; p < P; ++p) {
-      t = t1;
-      h = h_h0;
-      logfacold = bi::log(BI_REAL(1.0e-4));
-      n = 0;
-      host_load<B,S>(s, p, old);
-      r1 = old;
-
-      /* integrate */
-      while (t < t2 && n < h_nsteps) {
-        if (BI_REAL(0.1)*bi::abs(h) <= bi::abs(t)*h_uround) {
-          // step size too small
-        }
-        if (t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0)) {
-          h = t2 - t;
-          if (h <= BI_REAL(0.0)) {
-            t = t2;
-            break;
+    #ifdef ENABLE_DIAGNOSTICS
+    long steps = 0;
+    #endif
+
+    x.getCommon() = s.getCommon();
+
+    #pragma omp for schedule(dynamic) nowait
+    for (p1 = 0; p1 < P; p1 += BI_ODE_CHUNK_SIZE) {
+      /* load tile */
+      P1 = bi::min(BI_ODE_CHUNK_SIZE, P - p1);
+      rows(x.getTraj(), 0, P1) = rows(s.getTraj(), p1, P1);
+
+      for (q = 0; q < P1; ++q) {
+        p = p1 + q;
+        t = t1;
+        Persist::load(row(O, p), h, logfacold);
+        truncated = false;
+        n = 0;
+        host_load<B,S>(x, q, old);
+        r1 = old;
+
+        /* integrate */
+        while (t < t2 && n < h_nsteps) {
+          if (BI_REAL(0.1)*bi::abs(h) <= bi::abs(t)*h_uround) {
+            // step size too small
+          }
+          truncated = t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0);
+          if (truncated) {
+            hprop = h;
+            h = t2 - t;
+            if (h <= BI_REAL(0.0)) {
+              t = t2;
+              break;
+            }
           }
-        }
 
-        /* stages */
-        Visitor::stage1(t, h, s, p, pax, r1.buf(), r2.buf(), err.buf());
-        host_store<B,S>(s, p, r1);
+          /* stages */
+          Visitor::stage1(t, h, x, q, pax, r1.buf(), r2.buf(), err.buf());
+          host_store<B,S>(x, q, r1);
 
-        Visitor::stage2(t, h, s, p, pax, r1.buf(), r2.buf(), err.buf());
-        host_store<B,S>(s, p, r2);
+          Visitor::stage2(t, h, x, q, pax, r1.buf(), r2.buf(), err.buf());
+          host_store<B,S>(x, q, r2);
 
-        Visitor::stage3(t, h, s, p, pax, r1.buf(), r2.buf(), err.buf());
-        host_store<B,S>(s, p, r1);
+          Visitor::stage3(t, h, x, q, pax, r1.buf(), r2.buf(), err.buf());
+          host_store<B,S>(x, q, r1);
 
-        Visitor::stage4(t, h, s, p, pax, r1.buf(), r2.buf(), err.buf());
-        host_store<B,S>(s, p, r2);
+          Visitor::stage4(t, h, x, q, pax, r1.buf(), r2.buf(), err.buf());
+          host_store<B,S>(x, q, r2);
 
-        Visitor::stage5(t, h, s, p, pax, r1.buf(), r2.buf(), err.buf());
-        host_store<B,S>(s, p, r1);
+          Visitor::stage5(t, h, x, q, pax, r1.buf(), r2.buf(), err.buf());
+          host_store<B,S>(x, q, r1);
 
-        /* compute error */
-        e2 = BI_REAL(0.0);
-        for (id = 0; id < N; ++id) {
-          e = err(id)*h/(h_atoler + h_rtoler*bi::max(bi::abs(old(id)), bi::abs(r1(id))));
-          e2 += e*e;
-        }
-        e2 /= N;
+          /* compute error */
+          e2 = BI_REAL(0.0);
+          for (id = 0; id < N; ++id) {
+            e = err(id)*h/(h_atoler + h_rtoler*bi::max(bi::abs(old(id)), bi::abs(r1(id))));
+            e2 += e*e;
+          }
+          e2 /= N;
+
+          if (e2 <= BI_REAL(1.0)) {
+            /* accept */
+            t += h;
+            if (t < t2) {
+              old = r1;
+            }
+          } else {
+            /* reject */
+            r1 = old;
+            host_store<B,S>(x, q, old);
+          }
 
-        if (e2 <= BI_REAL(1.0)) {
-          /* accept */
-          t += h;
+          /* compute next step size */
           if (t < t2) {
-            old = r1;
+            logfac11 = h_expo*bi::log(e2);
+            if (e2 > BI_REAL(1.0)) {
+              /* step was rejected */
+              h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
+            } else {
+              /* step was accepted */
+              fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
+              fac = bi::min(h_facr, bi::max(h_facl, fac)); // bound
+              h *= fac;
+              logfacold = BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8)));
+            }
           }
-        } else {
-          /* reject */
-          r1 = old;
-          host_store<B,S>(s, p, old);
-        }
 
-        /* compute next step size */
-        if (t < t2) {
-          logfac11 = h_expo*bi::log(e2);
-          if (e2 > BI_REAL(1.0)) {
-            /* step was rejected */
-            h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
-          } else {
-            /* step was accepted */
-            fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
-            fac = bi::min(h_facr, bi::max(h_facl, fac)); // bound
-            h *= fac;
-            logfacold = BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8)));
-          }
+          ++n;
         }
 
-        ++n;
+        /* keep step size, as proposed before truncation at end of interval */
+        Persist::store(row(O, p), (truncated && t >= t2) ? bi::max(h, hprop) : h,
+            logfacold);
+
+        #ifdef ENABLE_DIAGNOSTICS
+        steps += n;
+        #endif
       }
+
+      /* store tile */
+      rows(s.getTraj(), p1, P1) = rows(x.getTraj(), 0, P1);
     }
+
+    #ifdef ENABLE_DIAGNOSTICS
+    diagnostics.record(steps);
+    #endif
   }
 }
 
@@ -0,0 +1,249 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_ODE_ROS3PINTEGRATORHOST_HPP
+#define BI_HOST_ODE_ROS3PINTEGRATORHOST_HPP
+
+namespace bi {
+/**
+ * ROS3P linearly implicit Rosenbrock integrator.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ * @tparam T1 Scalar type.
+ *
+ * Implements the three stage, order 3(2) ROS3P method of @ref Lang2001
+ * "Lang & Verwer (2001)", in the transformed formulation of @ref Hairer1996
+ * "Hairer & Wanner (1996)", so that each stage requires one solution of a
+ * linear system with the same matrix. The method is A-stable, and suited to
+ * stiff systems.
+ *
+ * The Jacobian is computed once per step from code generated by symbolic
+ * differentiation of the model, writing only its nonzero entries, and
+ * factorised with LAPACK. A step for which the matrix is singular is
+ * rejected.
+ *
+ * The embedded second order solution has the same stability function as the
+ * third order solution, so that the error estimate vanishes for linear
+ * autonomous systems (the second and first stages are then parallel, and no
+ * reweighting of the stages can avoid this). The estimate is still
+ * meaningful for nonlinear systems, but step size growth is limited to a
+ * factor of two per step, so that linear blocks do not run away to the end
+ * of each interval in a handful of steps. Such blocks should be given a
+ * small initial step size.
+ *
+ * The step size of each trajectory is kept between calls (see
+ * IntegratorState).
+ */
+template<class B, class S, class T1>
+class ROS3PIntegratorHost {
+public:
+  /**
+   * Integrate.
+   *
+   * @param t1 Start of time interval.
+   * @param t2 End of time interval.
+   * @param[in,out] s State.
+   */
+  static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
+};
+}
+
+#include "ROS3PVisitorHost.hpp"
+#include "IntegratorConstants.hpp"
+#include "IntegratorDiagnostics.hpp"
+#include "IntegratorState.hpp"
+#include "../host.hpp"
+#include "../math/lapack.hpp"
+#include "../math/temp_matrix.hpp"
+#include "../../state/Pa.hpp"
+#include "../../typelist/front.hpp"
+#include "../../typelist/pop_front.hpp"
+#include "../../traits/block_traits.hpp"
+#include "../../math/view.hpp"
+#include "../../math/temp_vector.hpp"
+
+#include "boost/typeof/typeof.hpp"
+
+template<class B, class S, class T1>
+void bi::ROS3PIntegratorHost<B,S,T1>::update(const T1 t1, const T1 t2,
+    State<B,ON_HOST>& s) {
+  /* pre-condition */
+  BI_ASSERT(t1 < t2);
+
+  typedef host_vector_reference<real> vector_reference_type;
+  typedef Pa<ON_HOST,B,host,host,host,host> PX;
+  typedef ROS3PVisitorHost<B,S,S,real,PX,real> Visitor;
+  typedef IntegratorState<B,S> Persist;
+
+  /* coefficients, see Lang & Verwer (2001) and Hairer & Wanner (1996) */
+  const real gamma = BI_REAL(0.788675134594812882254574390251);
+  const real a21 = BI_REAL(1.26794919243112270647255365849);
+  const real c21 = BI_REAL(-1.60769515458673623750573504904);
+  const real c31 = BI_REAL(-3.46410161513775458705489268301);
+  const real c32 = BI_REAL(-1.73205080756887729352744634151);
+  const real m1 = BI_REAL(2.0);
+  const real m2 = BI_REAL(0.577350269189625764509148780502);
+  const real m3 = BI_REAL(0.422649730810374235490851219498);
+  const real d1 = BI_REAL(-0.113248654051871177454256097491); // m1 - m1hat
+  const real d2 = BI_REAL(-0.422649730810374235490851219498); // m2 - m2hat
+  const real facmax = bi::min(h_facr, BI_REAL(2.0)); // see class notes
+
+  static const int N = block_size<S>::value;
+  const int P = s.size();
+
+  Persist::init(s);
+  BOOST_AUTO(O, s.getOde());
+
+  #ifdef ENABLE_DIAGNOSTICS
+  IntegratorDiagnostics diagnostics("ROS3PIntegratorHost");
+  #endif
+
+  #pragma omp parallel
+  {
+    real buf[7*N]; // use of dynamic array faster than heap allocation
+    vector_reference_type x0(buf, N);
+    vector_reference_type x1(buf + N, N);
+    vector_reference_type f1(buf + 2*N, N);
+    vector_reference_type k1(buf + 3*N, N);
+    vector_reference_type k2(buf + 4*N, N);
+    vector_reference_type k3(buf + 5*N, N);
+    vector_reference_type err(buf + 6*N, N);
+    temp_host_matrix<real>::type A(N, N);
+    int ipiv[N];
+
+    real t, h, hprop, e, e2, fac, ghinv, logfacold;
+    int n, id, jd, p, info, ld, nrhs, n1;
+    char trans = 'T';
+    bool rejected, truncated;
+    PX pax;
+    #ifdef ENABLE_DIAGNOSTICS
+    long steps = 0;
+    #endif
+
+    ld = A.lead();
+    nrhs = 1;
+    n1 = N;
+
+    #pragma omp for schedule(dynamic, BI_ODE_CHUNK_SIZE) nowait
+    for (p = 0; p < P; ++p) {
+      t = t1;
+      Persist::load(row(O, p), h, logfacold); // logfacold unused
+      rejected = false;
+      truncated = false;
+      n = 0;
+      host_load<B,S>(s, p, x0);
+
+      /* integrate */
+      while (t < t2 && n < h_nsteps) {
+        truncated = t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0);
+        if (truncated) {
+          hprop = h;
+          h = t2 - t;
+          if (h <= BI_REAL(0.0)) {
+            t = t2;
+            break;
+          }
+        }
+
+        /* derivatives and Jacobian, state in s is always x0 on entry; the
+         * Jacobian is assembled transposed so that each of its rows is
+         * contiguous, and solves use the transpose of the factorisation */
+        Visitor::dfdt(t, s, p, pax, k1.buf());
+        A.clear();
+        Visitor::jacobian(t, s, p, pax, A.buf(), ld);
+
+        /* factorise I/(h*gamma) - J */
+        ghinv = BI_REAL(1.0)/(h*gamma);
+        for (jd = 0; jd < N; ++jd) {
+          for (id = 0; id < N; ++id) {
+            A(id, jd) = -A(id, jd);
+          }
+          A(jd, jd) += ghinv;
+        }
+        lapack_getrf<real>::func(&n1, &n1, A.buf(), &ld, ipiv, &info);
+
+        if (info == 0) {
+          /* stage 1 */
+          lapack_getrs<real>::func(&trans, &n1, &nrhs, A.buf(), &ld, ipiv,
+              k1.buf(), &n1, &info);
+
+          /* stage 2 */
+          for (id = 0; id < N; ++id) {
+            x1(id) = x0(id) + a21*k1(id);
+          }
+          host_store<B,S>(s, p, x1);
+          Visitor::dfdt(t + h, s, p, pax, f1.buf());
+          for (id = 0; id < N; ++id) {
+            k2(id) = f1(id) + (c21/h)*k1(id);
+          }
+          lapack_getrs<real>::func(&trans, &n1, &nrhs, A.buf(), &ld, ipiv,
+              k2.buf(), &n1, &info);
+
+          /* stage 3, reuses derivatives of stage 2 */
+          for (id = 0; id < N; ++id) {
+            k3(id) = f1(id) + (c31*k1(id) + c32*k2(id))/h;
+          }
+          lapack_getrs<real>::func(&trans, &n1, &nrhs, A.buf(), &ld, ipiv,
+              k3.buf(), &n1, &info);
+
+          /* solution and error */
+          e2 = BI_REAL(0.0);
+          for (id = 0; id < N; ++id) {
+            x1(id) = x0(id) + m1*k1(id) + m2*k2(id) + m3*k3(id);
+            err(id) = d1*k1(id) + d2*k2(id);
+            e = err(id)/(h_atoler + h_rtoler*bi::max(bi::abs(x0(id)), bi::abs(x1(id))));
+            e2 += e*e;
+          }
+          e2 /= N;
+        } else {
+          /* singular, reject */
+          e2 = BI_REAL(1.0)/BI_REAL(0.0);
+        }
+
+        if (e2 <= BI_REAL(1.0)) {
+          /* accept */
+          t += h;
+          x0 = x1;
+          host_store<B,S>(s, p, x0);
+          fac = bi::exp(h_logsafe - bi::log(e2)/BI_REAL(6.0));
+          fac = bi::min(facmax, bi::max(h_facl, fac)); // bound
+          if (rejected) {
+            /* no increase straight after a rejection */
+            fac = bi::min(BI_REAL(1.0), fac);
+          }
+          rejected = false;
+        } else {
+          /* reject */
+          host_store<B,S>(s, p, x0);
+          fac = bi::max(h_facl, bi::exp(h_logsafe - bi::log(e2)/BI_REAL(6.0)));
+          fac = bi::min(BI_REAL(1.0), fac);
+          rejected = true;
+        }
+        h *= fac;
+
+        ++n;
+      }
+
+      /* keep step size, as proposed before truncation at end of interval */
+      Persist::store(row(O, p), (truncated && t >= t2) ? bi::max(h, hprop) : h,
+          logfacold);
+
+      #ifdef ENABLE_DIAGNOSTICS
+      steps += n;
+      #endif
+    }
+
+    #ifdef ENABLE_DIAGNOSTICS
+    diagnostics.record(steps);
+    #endif
+  }
+}
+
+#endif
@@ -0,0 +1,351 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_PRIMITIVE_VECTORPRIMITIVE_HPP
+#define BI_HOST_PRIMITIVE_VECTORPRIMITIVE_HPP
+
+/**
+ * @def BI_PRIMITIVE_BLOCK_SIZE
+ *
+ * Number of elements in each block of reductions and scans on host. Blocks
+ * are distributed across threads, and partial results combined in block
+ * order, so that results depend on this, but not on the number of threads.
+ */
+#define BI_PRIMITIVE_BLOCK_SIZE 4096
+
+namespace bi {
+/**
+ * @internal
+ */
+template<>
+struct op_reduce_impl<ON_HOST> {
+  template<class V1, class UnaryFunctor, class BinaryFunctor>
+  static typename V1::value_type func(const V1 x, UnaryFunctor op1,
+      const typename V1::value_type init, BinaryFunctor op2);
+};
+
+/**
+ * @internal
+ */
+template<>
+struct max_reduce_impl<ON_HOST> {
+  template<class V1>
+  static typename V1::value_type func(const V1 x);
+};
+
+/**
+ * @internal
+ *
+ * Fuses the maximum with the sum of exponentials, so that each block is
+ * read from main memory once.
+ */
+template<>
+struct logsumexp_reduce_impl<ON_HOST> {
+  template<class V1>
+  static typename V1::value_type func(const V1 x);
+};
+
+/**
+ * @internal
+ *
+ * Uses weight_stats_reduce_impl<ON_HOST>.
+ */
+template<>
+struct ess_reduce_impl<ON_HOST> {
+  template<class V1>
+  static typename V1::value_type func(const V1 lws);
+};
+
+/**
+ * @internal
+ *
+ * Fuses the maximum with both sums of exponentials, so that each block is
+ * read from main memory once.
+ */
+template<>
+struct weight_stats_reduce_impl<ON_HOST> {
+  template<class V1>
+  static void func(const V1 lws, typename V1::value_type& mx,
+      typename V1::value_type& sum1, typename V1::value_type& sum2);
+};
+
+/**
+ * @internal
+ *
+ * Two-pass blocked scan: block totals are computed in parallel, scanned
+ * serially, then used to offset a parallel scan within each block.
+ */
+template<>
+struct op_exclusive_scan_impl<ON_HOST> {
+  template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+  static void func(const V1 x, V2 y, const typename V1::value_type init,
+      UnaryFunctor op1, BinaryFunctor op2);
+};
+
+/**
+ * @internal
+ *
+ * @copydoc op_exclusive_scan_impl<ON_HOST>
+ */
+template<>
+struct op_inclusive_scan_impl<ON_HOST> {
+  template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+  static void func(const V1 x, V2 y, UnaryFunctor op1, BinaryFunctor op2);
+};
+}
+
+#include "../../math/function.hpp"
+
+#include <vector>
+
+template<class V1, class UnaryFunctor, class BinaryFunctor>
+typename V1::value_type bi::op_reduce_impl<bi::ON_HOST>::func(const V1 x,
+    UnaryFunctor op1, const typename V1::value_type init, BinaryFunctor op2) {
+  typedef typename V1::value_type T1;
+
+  const int N = x.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T1> partials(B);
+  T1 result = init;
+  int b;
+
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T1 partial = op1(x(start));
+    for (int i = start + 1; i < end; ++i) {
+      partial = op2(partial, op1(x(i)));
+    }
+    partials[b] = partial;
+  }
+  for (b = 0; b < B; ++b) {
+    result = op2(result, partials[b]);
+  }
+  return result;
+}
+
+template<class V1>
+typename V1::value_type bi::max_reduce_impl<bi::ON_HOST>::func(const V1 x) {
+  typedef typename V1::value_type T1;
+
+  /* bi::max ignores NaN, consistent with nan_less_functor */
+  const int N = x.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T1> partials(B);
+  T1 result;
+  int b;
+
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T1 partial = x(start);
+    for (int i = start + 1; i < end; ++i) {
+      partial = bi::max(partial, x(i));
+    }
+    partials[b] = partial;
+  }
+  result = partials[0];
+  for (b = 1; b < B; ++b) {
+    result = bi::max(result, partials[b]);
+  }
+  return result;
+}
+
+template<class V1>
+typename V1::value_type bi::logsumexp_reduce_impl<bi::ON_HOST>::func(
+    const V1 x) {
+  /* pre-condition */
+  BI_ASSERT(x.size() > 0);
+
+  typedef typename V1::value_type T1;
+
+  const int N = x.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T1> mxs(B), sums(B);
+  T1 mx, sum;
+  int b;
+
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T1 mx1 = x(start), sum1 = 0.0;
+    int i;
+    for (i = start + 1; i < end; ++i) {
+      mx1 = bi::max(mx1, x(i));
+    }
+    for (i = start; i < end; ++i) {
+      sum1 += bi::nanexp(x(i) - mx1);
+    }
+    mxs[b] = mx1;
+    sums[b] = sum1;
+  }
+
+  /* rescale block sums to the global maximum */
+  mx = mxs[0];
+  for (b = 1; b < B; ++b) {
+    mx = bi::max(mx, mxs[b]);
+  }
+  sum = 0.0;
+  for (b = 0; b < B; ++b) {
+    if (sums[b] > 0.0) {
+      sum += sums[b]*bi::exp(mxs[b] - mx);
+    }
+  }
+  return mx + bi::log(sum);
+}
+
+template<class V1>
+typename V1::value_type bi::ess_reduce_impl<bi::ON_HOST>::func(
+    const V1 lws) {
+  typedef typename V1::value_type T1;
+
+  T1 mx, sum1, sum2;
+  weight_stats_reduce_impl<ON_HOST>::func(lws, mx, sum1, sum2);
+
+  return (sum1*sum1)/sum2;
+}
+
+template<class V1>
+void bi::weight_stats_reduce_impl<bi::ON_HOST>::func(const V1 lws,
+    typename V1::value_type& mx, typename V1::value_type& sum1,
+    typename V1::value_type& sum2) {
+  /* pre-condition */
+  BI_ASSERT(lws.size() > 0);
+
+  typedef typename V1::value_type T1;
+
+  const int N = lws.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T1> mxs(B), sums1(B), sums2(B);
+  T1 w;
+  int b;
+
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T1 mx1 = lws(start), sum11 = 0.0, sum21 = 0.0, w1;
+    int i;
+    for (i = start + 1; i < end; ++i) {
+      mx1 = bi::max(mx1, lws(i));
+    }
+    for (i = start; i < end; ++i) {
+      w1 = bi::nanexp(lws(i) - mx1);
+      sum11 += w1;
+      sum21 += w1*w1;
+    }
+    mxs[b] = mx1;
+    sums1[b] = sum11;
+    sums2[b] = sum21;
+  }
+
+  /* rescale block sums to the global maximum */
+  mx = mxs[0];
+  for (b = 1; b < B; ++b) {
+    mx = bi::max(mx, mxs[b]);
+  }
+  sum1 = 0.0;
+  sum2 = 0.0;
+  for (b = 0; b < B; ++b) {
+    if (sums1[b] > 0.0) {
+      w = bi::exp(mxs[b] - mx);
+      sum1 += sums1[b]*w;
+      sum2 += sums2[b]*w*w;
+    }
+  }
+}
+
+template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+void bi::op_exclusive_scan_impl<bi::ON_HOST>::func(const V1 x, V2 y,
+    const typename V1::value_type init, UnaryFunctor op1,
+    BinaryFunctor op2) {
+  typedef typename V2::value_type T2;
+
+  const int N = x.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T2> offsets(B);
+  int b;
+
+  /* block totals; last block not needed */
+  #pragma omp parallel for if(B > 2)
+  for (b = 0; b < B - 1; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = start + BI_PRIMITIVE_BLOCK_SIZE;
+    T2 total = op1(x(start));
+    for (int i = start + 1; i < end; ++i) {
+      total = op2(total, op1(x(i)));
+    }
+    offsets[b] = total;
+  }
+
+  /* exclusive scan of block totals */
+  T2 offset = init, total;
+  for (b = 0; b < B; ++b) {
+    total = offsets[b];
+    offsets[b] = offset;
+    offset = op2(offset, total);
+  }
+
+  /* scan within blocks; x is read before y is written, so may alias */
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T2 acc = offsets[b], z;
+    for (int i = start; i < end; ++i) {
+      z = op1(x(i));
+      y(i) = acc;
+      acc = op2(acc, z);
+    }
+  }
+}
+
+template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+void bi::op_inclusive_scan_impl<bi::ON_HOST>::func(const V1 x, V2 y,
+    UnaryFunctor op1, BinaryFunctor op2) {
+  typedef typename V2::value_type T2;
+
+  const int N = x.size();
+  const int B = (N + BI_PRIMITIVE_BLOCK_SIZE - 1)/BI_PRIMITIVE_BLOCK_SIZE;
+  std::vector<T2> offsets(B);
+  int b;
+
+  /* block totals; last block not needed */
+  #pragma omp parallel for if(B > 2)
+  for (b = 0; b < B - 1; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = start + BI_PRIMITIVE_BLOCK_SIZE;
+    T2 total = op1(x(start));
+    for (int i = start + 1; i < end; ++i) {
+      total = op2(total, op1(x(i)));
+    }
+    offsets[b] = total;
+  }
+
+  /* inclusive scan of block totals */
+  for (b = 1; b < B - 1; ++b) {
+    offsets[b] = op2(offsets[b - 1], offsets[b]);
+  }
+
+  /* scan within blocks */
+  #pragma omp parallel for if(B > 1)
+  for (b = 0; b < B; ++b) {
+    const int start = b*BI_PRIMITIVE_BLOCK_SIZE;
+    const int end = bi::min(start + BI_PRIMITIVE_BLOCK_SIZE, N);
+    T2 acc = (b > 0) ? op2(offsets[b - 1], op1(x(start))) : op1(x(start));
+    y(start) = acc;
+    for (int i = start + 1; i < end; ++i) {
+      acc = op2(acc, op1(x(i)));
+      y(i) = acc;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_RANDOM_PHILOX_HPP
+#define BI_HOST_RANDOM_PHILOX_HPP
+
+#include "boost/cstdint.hpp"
+
+namespace bi {
+/**
+ * Counter-based pseudorandom number generator, on host.
+ *
+ * @ingroup math_rng
+ *
+ * Implements the Philox4x32-10 generator of
+ * @ref Salmon2011 "Salmon et al. (2011)", satisfying the uniform random
+ * number generator concept of Boost.Random so that it may be used with
+ * Boost.Random distributions.
+ *
+ * Each block of four 32-bit variates is a bijection of a 128-bit counter
+ * under a 64-bit key. The key holds the seed and the rank of the process.
+ * The counter holds the index of the block within a substream, along with
+ * the identity of that substream. After seed(), the substream is identified
+ * by a stream number, which should be unique to the thread. After seek(),
+ * the substream is identified by a particle index and epoch instead, so
+ * that the variates drawn for a particle are independent of the thread on
+ * which it is processed. As particle indices are local to the process, it
+ * is the rank in the key that keeps the particles of different processes
+ * apart.
+ *
+ * @section Philox_references References
+ *
+ * @anchor Salmon2011 Salmon, J. K.; Moraes, M. A.; Dror, R. O. & Shaw,
+ * D. E. Parallel random numbers: as easy as 1, 2, 3. <i>Proceedings of
+ * the International Conference for High Performance Computing, Networking,
+ * Storage and Analysis</i>, <b>2011</b>.
+ */
+class Philox {
+public:
+  typedef boost::uint32_t result_type;
+
+  static const bool has_fixed_range = false;
+
+  /**
+   * Constructor.
+   *
+   * @param seed Seed value.
+   * @param stream Stream number.
+   * @param rank Process rank.
+   */
+  Philox(const unsigned seed = 0, const unsigned stream = 0,
+      const unsigned rank = 0);
+
+  /**
+   * Seed.
+   *
+   * @param seed Seed value.
+   * @param stream Stream number.
+   * @param rank Process rank.
+   */
+  void seed(const unsigned seed, const unsigned stream = 0,
+      const unsigned rank = 0);
+
+  /**
+   * Seek to the start of the substream for a particle and epoch. The key,
+   * and so the rank, is unchanged.
+   *
+   * @param p Particle index.
+   * @param k Epoch.
+   */
+  void seek(const unsigned p, const unsigned k);
+
+  /**
+   * Generate variate.
+   */
+  result_type operator()();
+
+  /**
+   * Minimum variate.
+   */
+  result_type min() const;
+
+  /**
+   * Maximum variate.
+   */
+  result_type max() const;
+
+private:
+  /**
+   * Generate next block of variates.
+   */
+  void generate();
+
+  /**
+   * Key.
+   */
+  result_type key[2];
+
+  /**
+   * Counter.
+   */
+  result_type ctr[4];
+
+  /**
+   * Current block of variates.
+   */
+  result_type buf[4];
+
+  /**
+   * Position of next variate in current block.
+   */
+  int pos;
+};
+}
+
+inline bi::Philox::Philox(const unsigned seed, const unsigned stream,
+    const unsigned rank) {
+  this->seed(seed, stream, rank);
+}
+
+inline void bi::Philox::seed(const unsigned seed, const unsigned stream,
+    const unsigned rank) {
+  key[0] = seed;
+  key[1] = rank;
+  ctr[0] = 0;
+  ctr[1] = stream;
+  ctr[2] = 0;
+  ctr[3] = 0;
+  pos = 4;
+}
+
+inline void bi::Philox::seek(const unsigned p, const unsigned k) {
+  /* last word of counter distinguishes these from thread substreams */
+  ctr[0] = 0;
+  ctr[1] = p;
+  ctr[2] = k;
+  ctr[3] = 1;
+  pos = 4;
+}
+
+inline bi::Philox::result_type bi::Philox::operator()() {
+  if (pos == 4) {
+    generate();
+    ++ctr[0];
+    pos = 0;
+  }
+  return buf[pos++];
+}
+
+inline bi::Philox::result_type bi::Philox::min() const {
+  return 0;
+}
+
+inline bi::Philox::result_type bi::Philox::max() const {
+  return 0xFFFFFFFF;
+}
+
+inline void bi::Philox::generate() {
+  static const boost::uint32_t M0 = 0xD2511F53;
+  static const boost::uint32_t M1 = 0xCD9E8D57;
+  static const boost::uint32_t W0 = 0x9E3779B9;
+  static const boost::uint32_t W1 = 0xBB67AE85;
+
+  boost::uint32_t k0 = key[0], k1 = key[1];
+  boost::uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  boost::uint64_t prod0, prod1;
+  int i;
+
+  for (i = 0; i < 10; ++i) {
+    prod0 = static_cast<boost::uint64_t>(M0)*c0;
+    prod1 = static_cast<boost::uint64_t>(M1)*c2;
+
+    c0 = static_cast<boost::uint32_t>(prod1 >> 32) ^ c1 ^ k0;
+    c2 = static_cast<boost::uint32_t>(prod0 >> 32) ^ c3 ^ k1;
+    c1 = static_cast<boost::uint32_t>(prod1);
+    c3 = static_cast<boost::uint32_t>(prod0);
+
+    k0 += W0;
+    k1 += W1;
+  }
+
+  buf[0] = c0;
+  buf[1] = c1;
+  buf[2] = c2;
+  buf[3] = c3;
+}
+
+#endif
@@ -9,8 +9,12 @@
 
 #ifdef ENABLE_MPI
 #include "boost/mpi/communicator.hpp"
+#include "boost/mpi/collectives.hpp"
 #endif
 
+#include <vector>
+#include <algorithm>
+
 void bi::RandomHost::seeds(Random& rng, const unsigned seed) {
   #pragma omp parallel
   {
@@ -19,11 +23,39 @@ void bi::RandomHost::seeds(Random& rng, const unsigned seed) {
     const int rank = world.rank();
     const int size = world.size();
 
-    int s = seed*size*bi_omp_max_threads + rank*bi_omp_max_threads + bi_omp_tid;
+    int stream = rank*bi_omp_max_threads + bi_omp_tid;
+    int s = seed*size*bi_omp_max_threads + stream;
     #else
-    int s = seed*bi_omp_max_threads + bi_omp_tid;
+    int stream = bi_omp_tid;
+    int s = seed*bi_omp_max_threads + stream;
     #endif
 
+    #ifdef ENABLE_PHILOX
+    /* common key for all threads of the process, distinguished by stream
+     * instead, while the key distinguishes processes */
+    #ifdef ENABLE_MPI
+    rng.getHostRng().rng.seed(seed, bi_omp_tid, rank);
+    #else
+    rng.getHostRng().rng.seed(seed, stream);
+    #endif
+    #else
     rng.getHostRng().seed(s);
+    #endif
   }
+
+  #if defined(ENABLE_PHILOX) && defined(ENABLE_MPI) && !defined(NDEBUG)
+  /* check that the same particle of different processes draws different
+   * variates */
+  boost::mpi::communicator world;
+  Philox probe(seed, 0, world.rank());
+  probe.seek(0, 0);
+  boost::uint64_t x = probe();
+  x = (x << 32) | probe();
+
+  std::vector<boost::uint64_t> xs;
+  boost::mpi::all_gather(world, x, xs);
+  std::sort(xs.begin(), xs.end());
+  BI_ASSERT_MSG(std::adjacent_find(xs.begin(), xs.end()) == xs.end(),
+      "Random number streams of two processes coincide");
+  #endif
 }
@@ -62,6 +62,8 @@ struct RandomHost {
 }
 
 #include "../../random/Random.hpp"
+#include "../../math/view.hpp"
+#include "../../math/function.hpp"
 
 template<class V1>
 void bi::RandomHost::uniforms(Random& rng, V1 x,
@@ -70,20 +72,18 @@ void bi::RandomHost::uniforms(Random& rng, V1 x,
   /* pre-condition */
   BI_ASSERT(upper >= lower);
 
-  typedef typename V1::value_type T1;
-  typedef boost::uniform_real<T1> dist_type;
+  const unsigned k = rng.nextEpoch();
 
   #pragma omp parallel
   {
     RngHost& rng1 = rng.getHostRng();
-    int j;
-
-    dist_type dist(lower, upper);
-    boost::variate_generator<RngHost::rng_type&, dist_type> gen(rng1.rng, dist);
+    int j, len;
 
-    #pragma omp for
-    for (j = 0; j < x.size(); ++j) {
-      x(j) = gen();
+    #pragma omp for schedule(static)
+    for (j = 0; j < x.size(); j += BI_RNG_BATCH_SIZE) {
+      len = bi::min(BI_RNG_BATCH_SIZE, x.size() - j);
+      rng1.seek(j, k);
+      rng1.uniforms(subrange(x, j, len), lower, upper);
     }
   }
 }
@@ -94,20 +94,18 @@ void bi::RandomHost::gaussians(Random& rng, V1 x,
   /* pre-condition */
   BI_ASSERT(sigma >= 0.0);
 
-  typedef typename V1::value_type T1;
-  typedef boost::normal_distribution<T1> dist_type;
+  const unsigned k = rng.nextEpoch();
 
   #pragma omp parallel
   {
     RngHost& rng1 = rng.getHostRng();
-    int j;
-
-    dist_type dist(mu, sigma);
-    boost::variate_generator<RngHost::rng_type&, dist_type> gen(rng1.rng, dist);
+    int j, len;
 
     #pragma omp for schedule(static)
-    for (j = 0; j < x.size(); ++j) {
-      x(j) = gen();
+    for (j = 0; j < x.size(); j += BI_RNG_BATCH_SIZE) {
+      len = bi::min(BI_RNG_BATCH_SIZE, x.size() - j);
+      rng1.seek(j, k);
+      rng1.gaussians(subrange(x, j, len), mu, sigma);
     }
   }
 }
@@ -118,20 +116,18 @@ void bi::RandomHost::gammas(Random& rng, V1 x,
   /* pre-condition */
   BI_ASSERT(alpha > 0.0 && beta > 0.0);
 
-  typedef typename V1::value_type T1;
-  typedef boost::gamma_distribution<T1> dist_type;
+  const unsigned k = rng.nextEpoch();
 
   #pragma omp parallel
   {
     RngHost& rng1 = rng.getHostRng();
-    int j;
-
-    dist_type dist(alpha);
-    boost::variate_generator<RngHost::rng_type&, dist_type> gen(rng1.rng, dist);
+    int j, len;
 
     #pragma omp for schedule(static)
-    for (j = 0; j < x.size(); ++j) {
-      x(j) = beta*gen();
+    for (j = 0; j < x.size(); j += BI_RNG_BATCH_SIZE) {
+      len = bi::min(BI_RNG_BATCH_SIZE, x.size() - j);
+      rng1.seek(j, k);
+      rng1.gammas(subrange(x, j, len), alpha, beta);
     }
   }
 }
@@ -143,23 +139,24 @@ void bi::RandomHost::betas(Random& rng, V1 x,
   BI_ASSERT(alpha > 0.0 && beta > 0.0);
 
   typedef typename V1::value_type T1;
-  typedef boost::gamma_distribution<T1> dist_type;
+
+  const unsigned k = rng.nextEpoch();
 
   #pragma omp parallel
   {
     RngHost& rng1 = rng.getHostRng();
-    int j;
-
-    dist_type dist1(alpha), dist2(beta);
-    boost::variate_generator<RngHost::rng_type&, dist_type> gen1(rng1.rng, dist1), gen2(rng1.rng, dist2);
-    T1 y1, y2;
+    typename temp_host_vector<T1>::type y1(BI_RNG_BATCH_SIZE), y2(BI_RNG_BATCH_SIZE);
+    int i, j, len;
 
     #pragma omp for schedule(static)
-    for (j = 0; j < x.size(); ++j) {
-      y1 = gen1();
-      y2 = gen2();
-
-      x(j) = y1/(y1 + y2);
+    for (j = 0; j < x.size(); j += BI_RNG_BATCH_SIZE) {
+      len = bi::min(BI_RNG_BATCH_SIZE, x.size() - j);
+      rng1.seek(j, k);
+      rng1.gammas(subrange(y1.ref(), 0, len), alpha, static_cast<T1>(1.0));
+      rng1.gammas(subrange(y2.ref(), 0, len), beta, static_cast<T1>(1.0));
+      for (i = 0; i < len; ++i) {
+        x(j + i) = y1(i)/(y1(i) + y2(i));
+      }
     }
   }
 }
@@ -0,0 +1,227 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_HOST_RANDOM_RNGBATCHHOST_HPP
+#define BI_HOST_RANDOM_RNGBATCHHOST_HPP
+
+#include "RngHost.hpp"
+#include "../math/temp_vector.hpp"
+#include "../../math/scalar.hpp"
+
+/**
+ * @def BI_RNG_BATCH_MAX
+ *
+ * Maximum number of variates pre-drawn at a time by RngBatchHost.
+ */
+#define BI_RNG_BATCH_MAX 4096
+
+namespace bi {
+/**
+ * Pseudorandom number generator with pre-drawn variates, on host.
+ *
+ * @ingroup math_rng
+ *
+ * Wraps RngHost, pre-drawing standard uniform and Gaussian variates in
+ * batches with RngHost::uniforms and RngHost::gaussians, then serving
+ * singular requests from these. The interface matches that of RngHost, so
+ * that it may be passed to actions in place of it. Samplers construct one
+ * per thread, sized to cover all of the noise variables for the particles
+ * of that thread, up to #BI_RNG_BATCH_MAX, so that the column of noise is
+ * drawn in a few batches rather than one variate at a time in each
+ * particle's visitor. The buffer of each kind of variate is allocated when
+ * first used.
+ *
+ * Pre-drawn variates are not returned to the underlying generator, so the
+ * object should be short-lived.
+ */
+class RngBatchHost {
+public:
+  /**
+   * Constructor.
+   *
+   * @param rng Underlying random number generator.
+   * @param n Number of variates to draw in each batch. At most
+   * #BI_RNG_BATCH_MAX are drawn.
+   */
+  RngBatchHost(RngHost& rng, const int n = BI_RNG_BATCH_SIZE);
+
+  /**
+   * @copydoc RngHost::seek
+   *
+   * When the counter-based generator is in use, pre-drawn variates are
+   * discarded.
+   */
+  void seek(const int p, const unsigned k);
+
+  /**
+   * @copydoc Random::uniformInt
+   */
+  template<class T1>
+  T1 uniformInt(const T1 lower = 0, const T1 upper = 1);
+
+  /**
+   * @copydoc Random::multinomial
+   */
+  template<class V1>
+  typename V1::difference_type multinomial(const V1 lps);
+
+  /**
+   * @copydoc Random::uniform
+   */
+  template<class T1>
+  T1 uniform(const T1 lower = 0.0, const T1 upper = 1.0);
+
+  /**
+   * @copydoc Random::gaussian
+   */
+  template<class T1>
+  T1 gaussian(const T1 mu = 0.0, const T1 sigma = 1.0);
+
+  /**
+   * @copydoc Random::gamma
+   *
+   * Uses the method of @ref Marsaglia2000 "Marsaglia & Tsang (2000)".
+   */
+  template<class T1>
+  T1 gamma(const T1 alpha = 1.0, const T1 beta = 1.0);
+
+private:
+  /**
+   * Next standard uniform variate.
+   */
+  real nextUniform();
+
+  /**
+   * Next standard Gaussian variate.
+   */
+  real nextGaussian();
+
+  /**
+   * Underlying random number generator.
+   */
+  RngHost& rng;
+
+  /**
+   * Pre-drawn standard uniform variates.
+   */
+  temp_host_vector<real>::type us;
+
+  /**
+   * Pre-drawn standard Gaussian variates.
+   */
+  temp_host_vector<real>::type zs;
+
+  /**
+   * Position of next variate in #us.
+   */
+  int iu;
+
+  /**
+   * Position of next variate in #zs.
+   */
+  int iz;
+
+  /**
+   * Number of variates to draw in each batch.
+   */
+  int n;
+};
+}
+
+#include "../../math/function.hpp"
+
+inline bi::RngBatchHost::RngBatchHost(RngHost& rng, const int n) :
+    rng(rng), iu(0), iz(0), n(bi::min(bi::max(n, 1), BI_RNG_BATCH_MAX)) {
+  //
+}
+
+inline void bi::RngBatchHost::seek(const int p, const unsigned k) {
+  #ifdef ENABLE_PHILOX
+  rng.seek(p, k);
+  iu = us.size();
+  iz = zs.size();
+  #endif
+}
+
+template<class T1>
+inline T1 bi::RngBatchHost::uniformInt(const T1 lower, const T1 upper) {
+  return rng.uniformInt(lower, upper);
+}
+
+template<class V1>
+inline typename V1::difference_type bi::RngBatchHost::multinomial(
+    const V1 lps) {
+  return rng.multinomial(lps);
+}
+
+template<class T1>
+inline T1 bi::RngBatchHost::uniform(const T1 lower, const T1 upper) {
+  /* pre-condition */
+  BI_ASSERT(upper >= lower);
+
+  return lower + (upper - lower)*nextUniform();
+}
+
+template<class T1>
+inline T1 bi::RngBatchHost::gaussian(const T1 mu, const T1 sigma) {
+  /* pre-condition */
+  BI_ASSERT(sigma >= 0.0);
+
+  return mu + sigma*nextGaussian();
+}
+
+template<class T1>
+T1 bi::RngBatchHost::gamma(const T1 alpha, const T1 beta) {
+  /* pre-condition */
+  BI_ASSERT(alpha > 0.0 && beta > 0.0);
+
+  /* for alpha < 1, shift shape up by one and correct afterward */
+  const bool shifted = alpha < static_cast<T1>(1.0);
+  const T1 a = shifted ? alpha + static_cast<T1>(1.0) : alpha;
+  const T1 d = a - static_cast<T1>(1.0/3.0);
+  const T1 c = static_cast<T1>(1.0)/bi::sqrt(static_cast<T1>(9.0)*d);
+  T1 z, v, u, x;
+
+  do {
+    do {
+      z = nextGaussian();
+      v = static_cast<T1>(1.0) + c*z;
+    } while (v <= static_cast<T1>(0.0));
+    v = v*v*v;
+    u = nextUniform();
+  } while (bi::log(u) >= static_cast<T1>(0.5)*z*z + d - d*v + d*bi::log(v));
+
+  x = d*v;
+  if (shifted) {
+    x *= bi::pow(static_cast<T1>(nextUniform()), static_cast<T1>(1.0)/alpha);
+  }
+  return beta*x;
+}
+
+inline real bi::RngBatchHost::nextUniform() {
+  if (iu == us.size()) {
+    if (us.size() == 0) {
+      us.resize(n);
+    }
+    rng.uniforms(us.ref());
+    iu = 0;
+  }
+  return us(iu++);
+}
+
+inline real bi::RngBatchHost::nextGaussian() {
+  if (iz == zs.size()) {
+    if (zs.size() == 0) {
+      zs.resize(n);
+    }
+    rng.gaussians(zs.ref());
+    iz = 0;
+  }
+  return zs(iz++);
+}
+
+#endif
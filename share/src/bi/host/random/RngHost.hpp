@@ -8,7 +8,18 @@
 #ifndef BI_HOST_RANDOM_RNG_HPP
 #define BI_HOST_RANDOM_RNG_HPP
 
+#ifdef ENABLE_PHILOX
+#include "Philox.hpp"
+#else
 #include "boost/random/mersenne_twister.hpp"
+#endif
+
+/**
+ * @def BI_RNG_BATCH_SIZE
+ *
+ * Number of variates drawn at a time by batch generation on host.
+ */
+#define BI_RNG_BATCH_SIZE 256
 
 namespace bi {
 /**
@@ -17,7 +28,10 @@ namespace bi {
  * @ingroup math_rng
  *
  * Uses the Mersenne Twister algorithm for generating pseudorandom variates,
- * as implemented in Boost.Random.
+ * as implemented in Boost.Random, or, when compiled with
+ * <tt>ENABLE_PHILOX</tt>, the counter-based Philox algorithm (see Philox).
+ * The latter supports #seek, so that the variates for a particle can be
+ * made independent of the number of threads and the schedule over them.
  *
  * @section RngHost_references References
  *
@@ -25,6 +39,10 @@ namespace bi {
  * T. Mersenne Twister: A 623-dimensionally equidistributed
  * uniform pseudorandom number generator. <i>ACM Transactions on
  * Modeling and Computer Simulation</i>, <b>1998</b>, 8, 3-30.
+ *
+ * @anchor Marsaglia2000 Marsaglia, G. and Tsang, W. W. A simple method for
+ * generating gamma variables. <i>ACM Transactions on Mathematical
+ * Software</i>, <b>2000</b>, 26, 363-372.
  */
 class RngHost {
 public:
@@ -35,6 +53,15 @@ public:
    */
   void seed(const unsigned seed);
 
+  /**
+   * Seek to the substream for a particle and epoch. Has no effect unless
+   * the counter-based generator is in use.
+   *
+   * @param p Particle index.
+   * @param k Epoch, as obtained from Random::nextEpoch().
+   */
+  void seek(const int p, const unsigned k);
+
   /**
    * @copydoc Random::uniformInt
    */
@@ -65,33 +92,144 @@ public:
   template<class T1>
   T1 gamma(const T1 alpha = 1.0, const T1 beta = 1.0);
 
+  /**
+   * @name Batch methods
+   *
+   * These fill a vector with variates from this generator alone. Raw
+   * variates are drawn first, then transformed in loops over contiguous
+   * storage.
+   */
+  //@{
+  /**
+   * @copydoc Random::uniforms
+   */
+  template<class V1>
+  void uniforms(V1 x, const typename V1::value_type lower = 0.0,
+      const typename V1::value_type upper = 1.0);
+
+  /**
+   * @copydoc Random::gaussians
+   */
+  template<class V1>
+  void gaussians(V1 x, const typename V1::value_type mu = 0.0,
+      const typename V1::value_type sigma = 1.0);
+
+  /**
+   * @copydoc Random::gammas
+   */
+  template<class V1>
+  void gammas(V1 x, const typename V1::value_type alpha = 1.0,
+      const typename V1::value_type beta = 1.0);
+
+  /**
+   * Fill vector with integer variates, uniform on <tt>[0,upper)</tt>, as
+   * for indices. Each is computed from one raw 32-bit variate as the high
+   * word of its product with @p upper, so that it does not pass through
+   * floating point, the precision of which would otherwise limit the
+   * indices that can be drawn.
+   *
+   * @tparam V1 Integer vector type.
+   *
+   * @param[out] x Vector.
+   * @param upper Upper bound on the interval, exclusive.
+   */
+  template<class V1>
+  void uniformInts(V1 x, const typename V1::value_type upper);
+  //@}
+
   /**
    * Random number generator type.
    */
+#ifdef ENABLE_PHILOX
+  typedef Philox rng_type;
+#else
   typedef boost::mt19937 rng_type;
+#endif
 
   /**
    * Random number generator.
    */
   rng_type rng;
+
+private:
+  /**
+   * Fill contiguous buffer with uniform variates.
+   *
+   * @param[out] x Buffer.
+   * @param n Length of buffer.
+   * @param lower Lower bound on the interval.
+   * @param upper Upper bound on the interval.
+   */
+  template<class T1>
+  void uniforms(T1* x, const int n, const T1 lower, const T1 upper);
+
+  /**
+   * Fill contiguous buffer with Gaussian variates, using the Box-Muller
+   * transform.
+   *
+   * @param[out] x Buffer.
+   * @param n Length of buffer.
+   * @param mu Mean.
+   * @param sigma Standard deviation.
+   */
+  template<class T1>
+  void gaussians(T1* x, const int n, const T1 mu, const T1 sigma);
+
+  /**
+   * Fill contiguous buffer with gamma variates, using the method of
+   * @ref Marsaglia2000 "Marsaglia & Tsang (2000)". Candidates are
+   * computed for the whole buffer at once, then any rejected are redrawn
+   * singly.
+   *
+   * @param[out] x Buffer.
+   * @param n Length of buffer.
+   * @param alpha Shape.
+   * @param beta Scale.
+   */
+  template<class T1>
+  void gammas(T1* x, const int n, const T1 alpha, const T1 beta);
+
+  /**
+   * Fill contiguous buffer with integer variates.
+   *
+   * @param[out] x Buffer.
+   * @param n Length of buffer.
+   * @param upper Upper bound on the interval, exclusive.
+   */
+  template<class T1>
+  void uniformInts(T1* x, const int n, const T1 upper);
 };
 }
 
+#include "../math/temp_vector.hpp"
 #include "../../misc/omp.hpp"
 #include "../../math/sim_temp_vector.hpp"
+#include "../../math/function.hpp"
+#include "../../math/pi.hpp"
 
 #include "boost/random/uniform_int.hpp"
 #include "boost/random/uniform_real.hpp"
 #include "boost/random/normal_distribution.hpp"
 #include "boost/random/gamma_distribution.hpp"
 #include "boost/random/variate_generator.hpp"
+#include "boost/math/special_functions/next.hpp"
+#include "boost/cstdint.hpp"
 
 #include "thrust/binary_search.h"
 
+#include <limits>
+#include <cmath>
+
 inline void bi::RngHost::seed(const unsigned seed) {
   rng.seed(seed);
 }
 
+inline void bi::RngHost::seek(const int p, const unsigned k) {
+  #ifdef ENABLE_PHILOX
+  rng.seek(p, k);
+  #endif
+}
+
 template<class T1>
 inline T1 bi::RngHost::uniformInt(const T1 lower, const T1 upper) {
   /* pre-condition */
@@ -160,4 +298,170 @@ inline T1 bi::RngHost::gamma(const T1 alpha, const T1 beta) {
   return beta*gen();
 }
 
+template<class V1>
+void bi::RngHost::uniforms(V1 x, const typename V1::value_type lower,
+    const typename V1::value_type upper) {
+  /* pre-condition */
+  BI_ASSERT(upper >= lower);
+
+  typedef typename V1::value_type T1;
+
+  if (x.inc() == 1) {
+    uniforms(x.buf(), x.size(), lower, upper);
+  } else {
+    typename temp_host_vector<T1>::type z(x.size());
+    uniforms(z.buf(), z.size(), lower, upper);
+    x = z;
+  }
+}
+
+template<class V1>
+void bi::RngHost::gaussians(V1 x, const typename V1::value_type mu,
+    const typename V1::value_type sigma) {
+  /* pre-condition */
+  BI_ASSERT(sigma >= 0.0);
+
+  typedef typename V1::value_type T1;
+
+  if (x.inc() == 1) {
+    gaussians(x.buf(), x.size(), mu, sigma);
+  } else {
+    typename temp_host_vector<T1>::type z(x.size());
+    gaussians(z.buf(), z.size(), mu, sigma);
+    x = z;
+  }
+}
+
+template<class V1>
+void bi::RngHost::gammas(V1 x, const typename V1::value_type alpha,
+    const typename V1::value_type beta) {
+  /* pre-condition */
+  BI_ASSERT(alpha > 0.0 && beta > 0.0);
+
+  typedef typename V1::value_type T1;
+
+  if (x.inc() == 1) {
+    gammas(x.buf(), x.size(), alpha, beta);
+  } else {
+    typename temp_host_vector<T1>::type z(x.size());
+    gammas(z.buf(), z.size(), alpha, beta);
+    x = z;
+  }
+}
+
+template<class V1>
+void bi::RngHost::uniformInts(V1 x, const typename V1::value_type upper) {
+  /* pre-condition */
+  BI_ASSERT(upper > 0);
+
+  typedef typename V1::value_type T1;
+
+  if (x.inc() == 1) {
+    uniformInts(x.buf(), x.size(), upper);
+  } else {
+    typename temp_host_vector<T1>::type z(x.size());
+    uniformInts(z.buf(), z.size(), upper);
+    x = z;
+  }
+}
+
+template<class T1>
+void bi::RngHost::uniformInts(T1* x, const int n, const T1 upper) {
+  const boost::uint64_t m = static_cast<boost::uint64_t>(upper);
+  boost::uint64_t u;
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    u = static_cast<boost::uint32_t>(rng() - rng.min());
+    x[i] = static_cast<T1>((u*m) >> 32);
+  }
+}
+
+template<class T1>
+void bi::RngHost::uniforms(T1* x, const int n, const T1 lower,
+    const T1 upper) {
+  /* raw variates are in [0,2^32), keep as many high bits as T1 represents
+   * exactly and offset by half, to give (0,1) */
+  const int bits = bi::min(std::numeric_limits<T1>::digits, 32);
+  const T1 a = static_cast<T1>(std::ldexp(1.0, -bits));
+  const T1 b = static_cast<T1>(0.5)*a;
+
+  /* rounding in the scale and shift to [lower,upper) may still reach
+   * upper, so clamp to the value just below it */
+  const T1 c = upper - lower;
+  const T1 top = (upper > lower) ? boost::math::float_prior(upper) : upper;
+  boost::uint32_t u;
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    u = static_cast<boost::uint32_t>(rng() - rng.min());
+    x[i] = static_cast<T1>(u >> (32 - bits));
+  }
+  for (i = 0; i < n; ++i) {
+    x[i] = bi::min(lower + c*(a*x[i] + b), top);
+  }
+}
+
+template<class T1>
+void bi::RngHost::gaussians(T1* x, const int n, const T1 mu,
+    const T1 sigma) {
+  const int h = n/2;
+  T1 r, theta;
+  int i;
+
+  uniforms(x, 2*h, static_cast<T1>(0.0), static_cast<T1>(1.0));
+  for (i = 0; i < h; ++i) {
+    r = sigma*bi::sqrt(static_cast<T1>(-2.0)*bi::log(x[i]));
+    theta = static_cast<T1>(BI_TWO_PI)*x[h + i];
+    x[i] = mu + r*bi::cos(theta);
+    x[h + i] = mu + r*bi::sin(theta);
+  }
+  if (2*h < n) {
+    x[n - 1] = gaussian(mu, sigma);
+  }
+}
+
+template<class T1>
+void bi::RngHost::gammas(T1* x, const int n, const T1 alpha,
+    const T1 beta) {
+  /* for alpha < 1, shift shape up by one and correct afterward */
+  const bool shifted = alpha < static_cast<T1>(1.0);
+  const T1 a = shifted ? alpha + static_cast<T1>(1.0) : alpha;
+  const T1 d = a - static_cast<T1>(1.0/3.0);
+  const T1 c = static_cast<T1>(1.0)/bi::sqrt(static_cast<T1>(9.0)*d);
+
+  typename temp_host_vector<T1>::type zs(n), us(n);
+  T1 z, v, u;
+  int i;
+
+  gaussians(zs.buf(), n, static_cast<T1>(0.0), static_cast<T1>(1.0));
+  uniforms(us.buf(), n, static_cast<T1>(0.0), static_cast<T1>(1.0));
+
+  /* candidates, rejections left as zero */
+  for (i = 0; i < n; ++i) {
+    z = zs(i);
+    v = static_cast<T1>(1.0) + c*z;
+    v = v*v*v;
+    u = us(i);
+    x[i] = (v > static_cast<T1>(0.0) && bi::log(u) < static_cast<T1>(0.5)*z*z + d - d*v + d*bi::log(v)) ? d*v : static_cast<T1>(0.0);
+  }
+
+  /* redraw rejections */
+  for (i = 0; i < n; ++i) {
+    if (x[i] <= static_cast<T1>(0.0)) {
+      x[i] = gamma(a, static_cast<T1>(1.0));
+    }
+  }
+
+  if (shifted) {
+    uniforms(us.buf(), n, static_cast<T1>(0.0), static_cast<T1>(1.0));
+    for (i = 0; i < n; ++i) {
+      x[i] *= bi::pow(us(i), static_cast<T1>(1.0)/alpha);
+    }
+  }
+  for (i = 0; i < n; ++i) {
+    x[i] *= beta;
+  }
+}
+
 #endif
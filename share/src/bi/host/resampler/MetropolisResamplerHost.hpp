@@ -8,35 +8,59 @@
 #ifndef BI_HOST_RESAMPLER_METROPOLISRESAMPLERHOST_HPP
 #define BI_HOST_RESAMPLER_METROPOLISRESAMPLERHOST_HPP
 
+#include "../math/temp_vector.hpp"
+#include "../../math/view.hpp"
+
 template<class V1, class V2>
 void bi::MetropolisResamplerHost::ancestors(Random& rng, const V1 lws,
     V2 as, int B) {
+  typedef typename V1::value_type T1;
+
   const int P1 = lws.size(); // number of particles
   const int P2 = as.size(); // number of ancestors to draw
+  const int L = BI_RNG_BATCH_SIZE; // number of chains run together
+  const unsigned e = rng.nextEpoch();
 
   #pragma omp parallel
   {
-    real alpha, lw1, lw2;
-    int k, p1, p2, p;
+    RngHost& rng1 = rng.getHostRng();
+    typename temp_host_vector<T1>::type alphas(L), lw1s(L);
+    typename temp_host_vector<int>::type p1s(L), p2s(L);
+    T1 lw2;
+    int j, k, l, n, p2;
+    bool accept;
 
-    #pragma omp for
-    for (p = 0; p < P2; ++p) {
-      p1 = p;
-      lw1 = lws(p);
+    #pragma omp for schedule(static)
+    for (j = 0; j < P2; j += L) {
+      n = bi::min(L, P2 - j);
+      rng1.seek(j, e);
+
+      for (l = 0; l < n; ++l) {
+        p1s(l) = j + l;
+        lw1s(l) = lws(j + l);
+      }
       for (k = 0; k < B; ++k) {
-        p2 = rng.uniformInt(0, P1 - 1);
-        lw2 = lws(p2);
-        alpha = rng.uniform<real>();
-
-        if (bi::log(alpha) < lw2 - lw1) {
-          /* accept */
-          p1 = p2;
-          lw1 = lw2;
+        /* proposals and log-acceptance thresholds for all chains */
+        rng1.uniformInts(subrange(p2s, 0, n), P1);
+        rng1.uniforms(subrange(alphas, 0, n));
+        for (l = 0; l < n; ++l) {
+          alphas(l) = bi::log(alphas(l));
+        }
+
+        /* step all chains, gathering proposed log-weights */
+        for (l = 0; l < n; ++l) {
+          p2 = p2s(l);
+          lw2 = lws(p2);
+          accept = alphas(l) < lw2 - lw1s(l);
+          p1s(l) = accept ? p2 : p1s(l);
+          lw1s(l) = accept ? lw2 : lw1s(l);
         }
       }
 
       /* write result */
-      as(p) = p1;
+      for (l = 0; l < n; ++l) {
+        as(j + l) = p1s(l);
+      }
     }
   }
 }
@@ -8,6 +8,9 @@
 #ifndef BI_HOST_RESAMPLER_REJECTIONRESAMPLERHOST_HPP
 #define BI_HOST_RESAMPLER_REJECTIONRESAMPLERHOST_HPP
 
+#include "../math/temp_vector.hpp"
+#include "../../math/view.hpp"
+
 template<class V1, class V2>
 void bi::RejectionResamplerHost::ancestors(Random& rng, const V1 lws,
     V2 as, const typename V1::value_type maxLogWeight) {
@@ -18,36 +21,60 @@ void bi::RejectionResamplerHost::ancestors(Random& rng, const V1 lws,
 
   const int P1 = lws.size(); // number of particles
   const int P2 = as.size(); // number of ancestors to draw
-  const T1 zero = 0.0;
-  const T1 maxWeight = bi::exp(maxLogWeight);
+  const int L = BI_RNG_BATCH_SIZE; // number of particles drawn together
+  const unsigned e = rng.nextEpoch();
 
   #pragma omp parallel
   {
-    real alpha, lw2;
-    int p, p2;
-
-    #pragma omp for
-    for (p = 0; p < P2; ++p) {
-      /* first proposal */
-      if (p < P2/P1*P1) {
-        /* death jump (stratified uniform) proposal */
-        p2 = p % P1;
-      } else {
-        /* random proposal */
-        p2 = rng.uniformInt(0, P1 - 1);
-      }
-      lw2 = lws(p2);
-      alpha = bi::log(rng.uniform(zero, maxWeight));
-
-      /* rejection loop */
-      while (alpha > lw2) {
-        p2 = rng.uniformInt(0, P1 - 1);
-        lw2 = lws(p2);
-        alpha = bi::log(rng.uniform(zero, maxWeight));
+    RngHost& rng1 = rng.getHostRng();
+    typename temp_host_vector<T1>::type alphas(L);
+    typename temp_host_vector<int>::type props(L), p2s(L), pending(L);
+    int i, j, l, m, m2, n, p;
+
+    #pragma omp for schedule(static)
+    for (j = 0; j < P2; j += L) {
+      n = bi::min(L, P2 - j);
+      rng1.seek(j, e);
+
+      /* all particles pending at first, with death jump (stratified
+       * uniform) proposal where possible, random proposal otherwise */
+      rng1.uniformInts(subrange(props, 0, n), P1);
+      for (l = 0; l < n; ++l) {
+        p = j + l;
+        if (p < P2/P1*P1) {
+          p2s(l) = p % P1;
+        } else {
+          p2s(l) = props(l);
+        }
+        pending(l) = l;
       }
+      m = n;
+
+      /* rejection loop, over those particles still pending */
+      while (m > 0) {
+        rng1.uniforms(subrange(alphas, 0, m));
+        for (i = 0; i < m; ++i) {
+          alphas(i) = bi::log(alphas(i)) + maxLogWeight;
+        }
+        m2 = 0;
+        for (i = 0; i < m; ++i) {
+          l = pending(i);
+          if (alphas(i) > lws(p2s(l))) {
+            pending(m2++) = l;
+          } else {
+            as(j + l) = p2s(l);
+          }
+        }
+        m = m2;
 
-      /* write result */
-      as(p) = p2;
+        /* new proposals for those rejected */
+        if (m > 0) {
+          rng1.uniformInts(subrange(props, 0, m), P1);
+          for (i = 0; i < m; ++i) {
+            p2s(pending(i)) = props(i);
+          }
+        }
+      }
     }
   }
 }
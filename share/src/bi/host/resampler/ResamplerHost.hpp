@@ -8,6 +8,8 @@
 #ifndef BI_HOST_RESAMPLER_RESAMPLERHOST_HPP
 #define BI_HOST_RESAMPLER_RESAMPLERHOST_HPP
 
+#include "../math/temp_vector.hpp"
+#include "../../math/view.hpp"
 #include "../../primitive/vector_primitive.hpp"
 
 template<class V1, class V2>
@@ -17,7 +19,10 @@ void bi::ResamplerHost::ancestorsToOffspring(const V1 as, V2 os) {
   BI_ASSERT(!V2::on_device);
 
   os.clear();
+
+  #pragma omp parallel for
   for (int p = 0; p < as.size(); ++p) {
+    #pragma omp atomic
     ++os(as(p));
   }
 
@@ -32,36 +37,64 @@ void bi::ResamplerHost::offspringToAncestors(const V1 os, V2 as) {
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o;
-  for (i = 0; i < os.size(); ++i) {
-    o = os(i);
-    for (j = 0; j < o; ++j) {
-      as(k++) = i;
-    }
-  }
+  typename temp_host_vector<int>::type Os(os.size());
+  op_inclusive_scan(os, Os, thrust::identity<int>(), thrust::plus<int>());
+  cumulativeOffspringToAncestors(Os, as);
 }
 
 template<class V1, class V2>
 void bi::ResamplerHost::offspringToAncestorsPermute(const V1 os, V2 as) {
   /* pre-conditions */
   BI_ASSERT(sum_reduce(os) == as.size());
+  BI_ASSERT(os.size() == as.size());
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o;
-  for (i = 0; i < os.size(); ++i) {
-    o = os(i);
-    if (o > 0) {
-      as(i) = i;
-      --o;
+  /* each particle with offspring is its own first offspring, the extra
+   * offspring of each, in order, fill the particles without offspring, in
+   * order; this is what a serial pass would produce, but here the ranks of
+   * both are obtained with scans, so that all work is O(P) and parallel */
+  const int P = as.size();
+
+  typename temp_host_vector<int>::type es(P), Es(P), Zs(P), frees(P), ancs(P);
+  int i, k, F;
+
+  #pragma omp parallel for
+  for (i = 0; i < P; ++i) {
+    es(i) = bi::max(os(i) - 1, 0);
+  }
+  op_exclusive_scan(es, Es, 0, thrust::identity<int>(), thrust::plus<int>());
+  op_exclusive_scan(os, Zs, 0, zero_functor<int>(), thrust::plus<int>());
+  F = (P > 0) ? Es(P - 1) + es(P - 1) : 0;
+
+  #pragma omp parallel
+  {
+    #pragma omp for
+    for (k = 0; k < F; ++k) {
+      ancs(k) = 0;
     }
-    for (j = 0; j < o; ++j) {
-      while (os(k) > 0) {
-        ++k;
+
+    #pragma omp for
+    for (i = 0; i < P; ++i) {
+      if (os(i) > 0) {
+        as(i) = i;
+        if (es(i) > 0) {
+          ancs(Es(i)) = i; // mark first extra offspring
+        }
+      } else {
+        frees(Zs(i)) = i;
       }
-      as(k++) = i;
     }
   }
+
+  /* propagate each mark over the rest of its extra offspring */
+  op_inclusive_scan(subrange(ancs, 0, F), subrange(ancs, 0, F),
+      thrust::identity<int>(), thrust::maximum<int>());
+
+  #pragma omp parallel for
+  for (k = 0; k < F; ++k) {
+    as(frees(k)) = ancs(k);
+  }
 }
 
 template<class V1, class V2>
@@ -96,53 +129,78 @@ void bi::ResamplerHost::cumulativeOffspringToAncestorsPermute(const V1 Os,
   BI_ASSERT(!V1::on_device);
   BI_ASSERT(!V2::on_device);
 
-  int i, j, k = 0, o, O1, O2;
-  for (i = 0; i < Os.size(); ++i) {
-    O1 = (i > 0) ? Os(i - 1) : 0;
-    O2 = Os(i);
-    o = O2 - O1;
+  typename temp_host_vector<int>::type os(Os.size());
 
-    if (o > 0) {
-      as(i) = i;
-      --o;
-    }
+  #pragma omp parallel for
+  for (int i = 0; i < Os.size(); ++i) {
+    os(i) = (i > 0) ? Os(i) - Os(i - 1) : Os(i);
+  }
+  offspringToAncestorsPermute(os, as);
+}
 
-    if (k == 0 && o > 0) { // deal with special case here rather than in loop
-      if (Os(k) > 0) {
-        ++k;
-      } else {
-        as(k++) = i;
-        --o;
-      }
-    }
+template<class V1>
+void bi::ResamplerHost::permute(V1 as) {
+  /* pre-condition */
+  BI_ASSERT(!V1::on_device);
 
-    for (j = 0; j < o; ++j) {
-      while (Os(k) - Os(k - 1) > 0) {
-        ++k;
+  const int P = as.size();
+
+  if (P > 0 && max_reduce(as) < P) {
+    /* go via offspring, parallel */
+    typename temp_host_vector<int>::type os(P);
+    ancestorsToOffspring(as, os);
+    offspringToAncestorsPermute(os, as);
+  } else {
+    /* ancestors outside range, serial */
+    typename V1::size_type i;
+    typename V1::value_type j, k;
+
+    for (i = 0; i < as.size(); ++i) {
+      k = as(i);
+      if (k < P && k != i && as(k) != k) {
+        /* swap */
+        j = as(k);
+        as(k) = k;
+        as(i) = j;
+        --i; // repeat for new value
       }
-      as(k++) = i;
     }
   }
 }
 
-template<class V1>
-void bi::ResamplerHost::permute(V1 as) {
+template<class V1, class M1>
+void bi::ResamplerHost::copy(const V1 as, M1 X) {
   /* pre-condition */
   BI_ASSERT(!V1::on_device);
+  BI_ASSERT(!M1::on_device);
+  BI_ASSERT(as.size() <= X.size1());
 
-  const int P = as.size();
+  /* rows per block, each block copied across all columns by one thread */
+  const int blockSize = 256;
 
-  typename V1::size_type i;
-  typename V1::value_type j, k;
+  typename temp_host_vector<int>::type is(as.size()), js(as.size());
+  int i, j, k, m, M = 0;
 
+  /* compact list of rows to be overwritten, and their ancestors */
   for (i = 0; i < as.size(); ++i) {
-    k = as(i);
-    if (k < P && k != i && as(k) != k) {
-      /* swap */
-      j = as(k);
-      as(k) = k;
-      as(i) = j;
-      --i; // repeat for new value
+    if (as(i) != i) {
+      is(M) = i;
+      js(M) = as(i);
+      ++M;
+    }
+  }
+
+  /* as ancestry is permuted, rows read are never written, so blocks are
+   * independent */
+  #ifndef __ICC // Intel compiler producing segfaults under OpenMP here
+  #pragma omp parallel for private(j, m) schedule(static)
+  #endif
+  for (k = 0; k < M; k += blockSize) {
+    const int end = bi::min(k + blockSize, M);
+    for (j = 0; j < X.size2(); ++j) {
+      for (m = k; m < end; ++m) {
+        X(is(m), j) = X(js(m), j);
+      }
     }
   }
 }
@@ -55,6 +55,8 @@ void bi::SparseStaticSamplerHost<B,S>::samples(Random& rng,
   typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
       ElementVisitor>::type Visitor;
 
+  const unsigned k = rng.nextEpoch();
+
 #pragma omp parallel
   {
     PX pax;
@@ -64,6 +66,7 @@ void bi::SparseStaticSamplerHost<B,S>::samples(Random& rng,
 
 #pragma omp for
     for (p = 0; p < s.size(); ++p) {
+      rng1.seek(s.start() + p, k);
       Visitor::accept(rng, s, mask, p, pax, x);
     }
   }
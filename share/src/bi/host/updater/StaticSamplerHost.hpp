@@ -8,6 +8,7 @@
 #ifndef BI_HOST_UPDATER_STATICSAMPLERHOST_HPP
 #define BI_HOST_UPDATER_STATICSAMPLERHOST_HPP
 
+#include "../random/RngBatchHost.hpp"
 #include "../../random/Random.hpp"
 #include "../../state/State.hpp"
 
@@ -44,7 +45,7 @@ public:
 
 template<class B, class S>
 void bi::StaticSamplerHost<B,S>::samples(Random& rng, State<B,ON_HOST>& s) {
-  typedef RngHost R1;
+  typedef RngBatchHost R1;
   typedef Pa<ON_HOST,B,host,host,host,host> PX;
   typedef Ou<ON_HOST,B,host> OX;
   typedef StaticSamplerMatrixVisitorHost<B,S,R1,PX,OX> MatrixVisitor;
@@ -52,15 +53,26 @@ void bi::StaticSamplerHost<B,S>::samples(Random& rng, State<B,ON_HOST>& s) {
   typedef typename boost::mpl::if_c<block_is_matrix<S>::value,MatrixVisitor,
       ElementVisitor>::type Visitor;
 
+  const unsigned k = rng.nextEpoch();
+
+  /* size of noise column to pre-draw on each thread, which RngBatchHost
+   * caps at BI_RNG_BATCH_MAX */
+  #ifdef ENABLE_PHILOX
+  const int n = block_size<S>::value;
+  #else
+  const int n = block_size<S>::value*((s.size() + bi_omp_max_threads - 1)/bi_omp_max_threads);
+  #endif
+
 #pragma omp parallel
   {
     PX pax;
     OX x;
-    R1& rng1 = rng.getHostRng();
+    R1 rng1(rng.getHostRng(), n);
     int p;
 
 #pragma omp for
     for (p = 0; p < s.size(); ++p) {
+      rng1.seek(s.start() + p, k);
       Visitor::accept(rng1, s, p, pax, x);
     }
   }
@@ -17,5 +17,8 @@
 #ifdef ENABLE_SSE
 #include "../sse/math/io.hpp"
 #endif
+#ifdef ENABLE_AVX
+#include "../avx/math/io.hpp"
+#endif
 
 #endif
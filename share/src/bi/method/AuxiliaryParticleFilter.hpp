@@ -409,8 +409,10 @@ real bi::AuxiliaryParticleFilter<B,S,R,IO1>::step(Random& rng,
   bool r = resample(rng, *iter, s, lw1s, lw2s, as);
   do {
     ++iter;
+    s.setContinuous(this->continuous(iter, last));
     this->predict(rng, *iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
+  s.setContinuous(false);
   real ll = this->correct(*iter, s, lw2s);
   this->output(*iter, s, r, lw2s, as);
 
@@ -426,8 +428,11 @@ real bi::AuxiliaryParticleFilter<B,S,R,IO1>::step(Random& rng,
   bool r = resample(rng, *iter, s, lw1s, lw2s, as);
   do {
     ++iter;
+    /* not past output times, where the first particle is overwritten */
+    s.setContinuous(!iter->hasOutput() && this->continuous(iter, last));
     this->predict(rng, *iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
+  s.setContinuous(false);
   row(s.getDyn(), 0) = column(X, iter->indexOutput());
   real ll = this->correct(*iter, s, lw2s);
   this->output(*iter, s, r, lw2s, as);
@@ -444,7 +449,10 @@ void bi::AuxiliaryParticleFilter<B,S,R,IO1>::lookahead(Random& rng,
     /* one or more observations remain, lookahead to next */
     typename loc_temp_matrix<L,real>::type X(s.getDyn().size1(),
         s.getDyn().size2());
+    typename loc_temp_matrix<L,real>::type O(s.getOde().size1(),
+        s.getOde().size2());
     X = s.getDyn();
+    O = s.getOde();
 
     lw1s = lw2s;
     ScheduleIterator iter1 = iter;
@@ -454,8 +462,15 @@ void bi::AuxiliaryParticleFilter<B,S,R,IO1>::lookahead(Random& rng,
     } while (!iter1->hasObs());
     lookaheadCorrect(*iter1, s, lw1s);
 
-    /* restore previous state */
+    /* restore previous state, including that of integrators */
     s.getDyn() = X;
+    if (s.getOde().size2() > O.size2()) {
+      /* columns added by lookahead hold nothing from before it */
+      columns(s.getOde(), O.size2(), s.getOde().size2() - O.size2()).clear();
+    }
+    if (O.size2() > 0) {
+      columns(s.getOde(), 0, O.size2()) = O;
+    }
   }
 }
 
@@ -10,6 +10,7 @@
 
 #include "../buffer/SparseInputNetCDFBuffer.hpp"
 #include "../cache/Cache2D.hpp"
+#include "../cache/ReadAhead.hpp"
 
 namespace bi {
 /**
@@ -28,6 +29,10 @@ namespace bi {
  * it in a valid state, unless that State object was in a valid state for
  * the previous time index. It is up to the user of the class to maintain
  * these semantics.
+ *
+ * Dynamic inputs not yet cached are read ahead of the caller, in time
+ * order, by a ReadAhead object. Clients construct a single Forcer for the
+ * whole run, so its caches serve every filter pass that follows.
  */
 template<class IO1 = SparseInputNetCDFBuffer, Location CL = ON_HOST>
 class Forcer {
@@ -36,8 +41,9 @@ public:
    * Constructor.
    *
    * @param in Input.
+   * @param N Number of times to read ahead.
    */
-  Forcer(IO1* in);
+  Forcer(IO1* in, const int N = 8);
 
   /**
    * Update dynamic inputs.
@@ -68,6 +74,11 @@ private:
    */
   IO1* in;
 
+  /**
+   * Reads of dynamic inputs.
+   */
+  ReadAhead<IO1> ahead;
+
   /**
    * Cache of dynamic inputs.
    */
@@ -107,7 +118,8 @@ struct ForcerFactory {
 }
 
 template<class IO1, bi::Location CL>
-bi::Forcer<IO1,CL>::Forcer(IO1* in) : in(in) {
+bi::Forcer<IO1,CL>::Forcer(IO1* in, const int N) : in(in),
+    ahead(in, F_VAR, N) {
   //
 }
 
@@ -117,7 +129,8 @@ inline void bi::Forcer<IO1,CL>::update(const int k, State<B,L>& s) {
   if (cache.isValid(k)) {
     vec(s.get(F_VAR)) = cache.get(k);
   } else {
-    in->read(k, F_VAR, s.get(F_VAR));
+    Mask<ON_HOST> mask;
+    ahead.readState(k, mask, s.get(F_VAR));
     cache.set(k, vec(s.get(F_VAR)));
   }
 }
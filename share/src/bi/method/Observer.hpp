@@ -12,6 +12,7 @@
 #include "../buffer/SparseInputNetCDFBuffer.hpp"
 #include "../cache/Cache2D.hpp"
 #include "../cache/CacheObject.hpp"
+#include "../cache/ReadAhead.hpp"
 
 namespace bi {
 /**
@@ -21,6 +22,15 @@ namespace bi {
  *
  * @tparam IO1 Input type.
  * @tparam CL Location for caches.
+ *
+ * Observations not yet cached are read ahead of the caller, in time order,
+ * by a ReadAhead object.
+ *
+ * One Observer is shared by all filters of a run, including across the
+ * iterations of ParticleMarginalMetropolisHastings and the
+ * \f$\theta\f$-particles of SMC2, so that observations are read once and
+ * cached once, whatever the number of either. With caches on host, masks
+ * are held once, and getMask() returns the same as getHostMask().
  */
 template<class IO1 = SparseInputNetCDFBuffer, Location CL = ON_HOST>
 class Observer {
@@ -29,8 +39,9 @@ public:
    * Constructor.
    *
    * @param in Input.
+   * @param N Number of times to read ahead.
    */
-  Observer(IO1* in);
+  Observer(IO1* in, const int N = 8);
 
   /**
    * Get mask on host.
@@ -68,6 +79,11 @@ private:
    */
   IO1* in;
 
+  /**
+   * Reads of observations.
+   */
+  ReadAhead<IO1> ahead;
+
   /**
    * Cache.
    */
@@ -79,11 +95,31 @@ private:
   CacheObject<Mask<ON_HOST> > maskHostCache;
 
   /**
-   * Cache for masks.
+   * Cache for masks. Unused with caches on host.
    */
   CacheObject<Mask<CL> > maskCache;
 };
 
+/**
+ * @internal
+ */
+template<Location CL>
+struct observer_mask_impl {
+  template<class O1>
+  static const Mask<CL>& func(O1& obs, CacheObject<Mask<CL> >& cache,
+      const int k);
+};
+
+/**
+ * @internal
+ */
+template<>
+struct observer_mask_impl<ON_HOST> {
+  template<class O1>
+  static const Mask<ON_HOST>& func(O1& obs,
+      CacheObject<Mask<ON_HOST> >& cache, const int k);
+};
+
 /**
  * Factory for creating Observer objects.
  *
@@ -112,7 +148,8 @@ struct ObserverFactory {
 }
 
 template<class IO1, bi::Location CL>
-bi::Observer<IO1,CL>::Observer(IO1* in) : in(in) {
+bi::Observer<IO1,CL>::Observer(IO1* in, const int N) : in(in),
+    ahead(in, O_VAR, N) {
   //
 }
 
@@ -120,7 +157,7 @@ template<class IO1, bi::Location CL>
 const bi::Mask<bi::ON_HOST>& bi::Observer<IO1,CL>::getHostMask(const int k) {
   if (!maskHostCache.isValid(k)) {
     Mask<ON_HOST> mask;
-    in->readMask(k, O_VAR, mask);
+    ahead.readMask(k, mask);
     maskHostCache.set(k, mask);
   }
   return maskHostCache.get(k);
@@ -128,10 +165,7 @@ const bi::Mask<bi::ON_HOST>& bi::Observer<IO1,CL>::getHostMask(const int k) {
 
 template<class IO1, bi::Location CL>
 const bi::Mask<CL>& bi::Observer<IO1,CL>::getMask(const int k) {
-  if (!maskCache.isValid(k)) {
-    maskCache.set(k, getHostMask(k));
-  }
-  return maskCache.get(k);
+  return observer_mask_impl<CL>::func(*this, maskCache, k);
 }
 
 template<class IO1, bi::Location CL>
@@ -140,9 +174,29 @@ inline void bi::Observer<IO1,CL>::update(const int k, State<B,L>& s) {
   if (cache.isValid(k)) {
     vec(s.get(OY_VAR)) = cache.get(k);
   } else {
-    in->readState(k, O_VAR, getHostMask(k), s.get(OY_VAR));
+    Mask<ON_HOST> mask;
+    ahead.readState(k, mask, s.get(OY_VAR));
+    if (!maskHostCache.isValid(k)) {
+      maskHostCache.set(k, mask);
+    }
     cache.set(k, vec(s.get(OY_VAR)));
   }
 }
 
+template<bi::Location CL>
+template<class O1>
+const bi::Mask<CL>& bi::observer_mask_impl<CL>::func(O1& obs,
+    CacheObject<Mask<CL> >& cache, const int k) {
+  if (!cache.isValid(k)) {
+    cache.set(k, obs.getHostMask(k));
+  }
+  return cache.get(k);
+}
+
+template<class O1>
+const bi::Mask<bi::ON_HOST>& bi::observer_mask_impl<bi::ON_HOST>::func(
+    O1& obs, CacheObject<Mask<ON_HOST> >& cache, const int k) {
+  return obs.getHostMask(k);
+}
+
 #endif
@@ -10,6 +10,7 @@
 
 #include "Simulator.hpp"
 #include "../cache/ParticleFilterCache.hpp"
+#include "../resampler/WeightStatistics.hpp"
 
 namespace bi {
 /**
@@ -87,6 +88,33 @@ public:
    */
   void setOutput(IO1* out);
 
+  /**
+   * Get tile size.
+   *
+   * @return Tile size.
+   */
+  int getTileSize() const;
+
+  /**
+   * Set tile size.
+   *
+   * @param tileSize Tile size. Zero to disable tiling.
+   *
+   * With a nonzero tile size, step() on host processes particles in tiles
+   * of this size, gathering the ancestors of each tile, then predicting and
+   * correcting it while it remains in cache, rather than making separate
+   * passes over all particles for each of these. The resampler must
+   * support a deferred copy (see #resampler_can_defer_copy), otherwise
+   * the untiled step is used. The tile size is rounded up as required by
+   * State::roundup() and State::padup(), so that each tile begins on an
+   * aligned boundary.
+   *
+   * Tiling requires the counter-based random number generator
+   * (<tt>ENABLE_PHILOX</tt>), so that results do not depend on the order
+   * in which particles are predicted.
+   */
+  void setTileSize(const int tileSize);
+
   /**
    * %Filter forward.
    *
@@ -227,6 +255,33 @@ public:
   real step(Random& rng, ScheduleIterator& iter, const ScheduleIterator last,
       State<B,L>& s, V1 lws, V2 as);
 
+  /**
+   * Resample, predict and correct, with statistics of log-weights carried
+   * between steps.
+   *
+   * @tparam L Location.
+   * @tparam V1 Vector type.
+   * @tparam V2 Vector type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param[in,out] iter Current position in time schedule. Advanced on
+   * return.
+   * @param last End of time schedule.
+   * @param[in,out] s State.
+   * @param[in,out] lws Log-weights.
+   * @param[out] as Ancestry after resampling.
+   * @param[in,out] stats Statistics of @p lws, as left by the previous
+   * correct() or step(), or invalid. Updated on return.
+   *
+   * @return Estimate of the incremental log-likelihood.
+   *
+   * The resampling decision and normalisation use @p stats where valid,
+   * rather than reducing over @p lws again.
+   */
+  template<bi::Location L, class V1, class V2>
+  real step(Random& rng, ScheduleIterator& iter, const ScheduleIterator last,
+      State<B,L>& s, V1 lws, V2 as, WeightStatistics& stats);
+
   /**
    * Resample, predict and correct, conditionally.
    *
@@ -251,6 +306,73 @@ public:
   real step(Random& rng, ScheduleIterator& iter, const ScheduleIterator last,
       State<B,L>& s, const M1 X, V1 lws, V2 as);
 
+  /**
+   * Resample, predict and correct, conditionally, with statistics of
+   * log-weights carried between steps.
+   *
+   * @tparam L Location.
+   * @tparam M1 Matrix type.
+   * @tparam V1 Vector type.
+   * @tparam V2 Vector type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param[in,out] iter Current position in time schedule. Advanced on
+   * return.
+   * @param last End of time schedule.
+   * @param[in,out] s State.
+   * @param X Path on which to condition. Rows index variables, columns
+   * index times.
+   * @param[in,out] lws Log-weights.
+   * @param[out] as Ancestry after resampling.
+   * @param[in,out] stats Statistics of @p lws, as left by the previous
+   * correct() or step(), or invalid. Updated on return.
+   *
+   * @return Estimate of the incremental log-likelihood.
+   */
+  template<bi::Location L, class M1, class V1, class V2>
+  real step(Random& rng, ScheduleIterator& iter, const ScheduleIterator last,
+      State<B,L>& s, const M1 X, V1 lws, V2 as, WeightStatistics& stats);
+
+  /**
+   * Resample, predict and correct, in tiles of particles.
+   *
+   * @tparam V1 Vector type.
+   * @tparam V2 Vector type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param[in,out] iter Current position in time schedule. Advanced on
+   * return.
+   * @param last End of time schedule.
+   * @param[in,out] s State.
+   * @param[in,out] lws Log-weights.
+   * @param[out] as Ancestry after resampling.
+   * @param[in,out] stats Statistics of @p lws.
+   *
+   * @return Estimate of the incremental log-likelihood.
+   *
+   * Ancestors are selected exactly as in step(), and the incremental
+   * log-likelihood is computed with the same reduction over all
+   * log-weights. Each tile is predicted from the same epoch of @p rng
+   * (see Random::nextEpoch()), and as the counter-based generator keys the
+   * variates of each particle by its index and epoch, a particle draws the
+   * same variates whichever tile it is in. Results are therefore identical
+   * to those of step().
+   */
+  template<class V1, class V2>
+  real stepTiled(Random& rng, ScheduleIterator& iter,
+      const ScheduleIterator last, State<B,ON_HOST>& s, V1 lws, V2 as,
+      WeightStatistics& stats);
+
+  /**
+   * @internal
+   *
+   * Tiling is not supported on device, does nothing.
+   */
+  template<bi::Location L, class V1, class V2>
+  real stepTiled(Random& rng, ScheduleIterator& iter,
+      const ScheduleIterator last, State<B,L>& s, V1 lws, V2 as,
+      WeightStatistics& stats);
+
   /**
    * Predict.
    *
@@ -263,6 +385,20 @@ public:
   template<Location L>
   void predict(Random& rng, const ScheduleElement next, State<B,L>& s);
 
+  /**
+   * Are trajectories continuous past the end of a step, so that
+   * integrators may step past it (see State::isContinuous())?
+   *
+   * @param iter Step in time schedule.
+   * @param last End of time schedule.
+   *
+   * @return True if another step follows, and nothing but the integration
+   * of ODEs changes the state between them: no observation, no delta and
+   * no input.
+   */
+  static bool continuous(const ScheduleIterator iter,
+      const ScheduleIterator last);
+
   /**
    * Update particle weights using observations at the current time.
    *
@@ -278,6 +414,29 @@ public:
   template<Location L, class V1>
   real correct(const ScheduleElement now, State<B,L>& s, V1 lws);
 
+  /**
+   * Update particle weights using observations at the current time, and
+   * statistics of them.
+   *
+   * @tparam L Location.
+   * @tparam V1 Vector type.
+   *
+   * @param now Current step in time schedule.
+   * @param s State.
+   * @param lws Log-weights.
+   * @param[in,out] stats Statistics of @p lws. Updated if there are
+   * observations at the current time, so that the following resample()
+   * need not reduce over @p lws again.
+   *
+   * @return Estimate of the incremental log-likelihood.
+   *
+   * The incremental log-likelihood and the statistics come from the same
+   * single reduction over @p lws.
+   */
+  template<Location L, class V1>
+  real correct(const ScheduleElement now, State<B,L>& s, V1 lws,
+      WeightStatistics& stats);
+
   /**
    * Resample.
    *
@@ -290,12 +449,14 @@ public:
    * @param[in,out] s State.
    * @param[in,out] lws Log-weights.
    * @param[out] as Ancestry after resampling.
+   * @param[in,out] stats Statistics of @p lws, or invalid, in which case
+   * they are computed. Invalidated on return, as @p lws are modified.
    *
    * @return True if resampling was performed, false otherwise.
    */
   template<Location L, class V1, class V2>
   bool resample(Random& rng, const ScheduleElement now, State<B,L>& s, V1 lws,
-      V2 as);
+      V2 as, WeightStatistics& stats);
 
   /**
    * Resample with conditioned outcome for first particle.
@@ -318,6 +479,29 @@ public:
   bool resample(Random& rng, const ScheduleElement now, State<B,L>& s,
       const int a, V1 lws, V2 as);
 
+  /**
+   * Resample, but defer the copy of particles to the caller.
+   *
+   * @tparam L Location.
+   * @tparam V1 Vector type.
+   * @tparam V2 Vector type.
+   *
+   * @param[in,out] rng Random number generator.
+   * @param now Current step in time schedule.
+   * @param s State.
+   * @param[in,out] lws Log-weights.
+   * @param[out] as Ancestry after resampling.
+   * @param[in,out] stats Statistics of @p lws, as for resample().
+   *
+   * @return True if resampling was performed, false otherwise.
+   *
+   * As resample(), but on return @p s is unchanged, and particles must be
+   * copied according to @p as by the caller.
+   */
+  template<Location L, class V1, class V2>
+  bool resampleDeferred(Random& rng, const ScheduleElement now,
+      State<B,L>& s, V1 lws, V2 as, WeightStatistics& stats);
+
   /**
    * Output static variables.
    *
@@ -378,6 +562,38 @@ protected:
    * Output.
    */
   IO1* out;
+
+  /**
+   * Tile size, zero if tiling disabled.
+   */
+  int tileSize;
+
+  /**
+   * Scratch state for tiled step.
+   */
+  State<B,ON_HOST> s1;
+};
+
+/**
+ * @internal
+ *
+ * Resampling with deferred copy, for resamplers that support it.
+ */
+template<bool defer>
+struct resample_deferred_impl {
+  template<class R, class V1, class V2>
+  static void func(Random& rng, R* resam, V1 lws, V2 as);
+};
+
+/**
+ * @internal
+ *
+ * Resampling with deferred copy, for resamplers that do not support it.
+ */
+template<>
+struct resample_deferred_impl<false> {
+  template<class R, class V1, class V2>
+  static void func(Random& rng, R* resam, V1 lws, V2 as);
 };
 
 /**
@@ -416,6 +632,7 @@ struct ParticleFilterFactory {
 };
 }
 
+#include "../resampler/Resampler.hpp"
 #include "../primitive/vector_primitive.hpp"
 #include "../primitive/matrix_primitive.hpp"
 #include "../traits/resampler_traits.hpp"
@@ -423,7 +640,7 @@ struct ParticleFilterFactory {
 template<class B, class S, class R, class IO1>
 bi::ParticleFilter<B,S,R,IO1>::ParticleFilter(B& m, S* sim, R* resam,
     IO1* out) :
-    m(m), sim(sim), resam(resam), out(out) {
+    m(m), sim(sim), resam(resam), out(out), tileSize(0) {
   /* pre-conditions */
   BI_ASSERT(sim != NULL);
 
@@ -460,6 +677,30 @@ inline void bi::ParticleFilter<B,S,R,IO1>::setOutput(IO1* out) {
   this->out = out;
 }
 
+template<class B, class S, class R, class IO1>
+inline int bi::ParticleFilter<B,S,R,IO1>::getTileSize() const {
+  return tileSize;
+}
+
+template<class B, class S, class R, class IO1>
+inline void bi::ParticleFilter<B,S,R,IO1>::setTileSize(const int tileSize) {
+  /* pre-condition */
+  BI_ASSERT(tileSize >= 0);
+
+  #ifndef ENABLE_PHILOX
+  BI_ERROR_MSG(tileSize == 0,
+      "Tiling requires the counter-based random number generator, build with --enable-philox");
+  #endif
+
+  if (tileSize > 0) {
+    /* padded, so that the start of each tile is also aligned */
+    this->tileSize = State<B,ON_HOST>::padup(
+        State<B,ON_HOST>::roundup(tileSize));
+  } else {
+    this->tileSize = 0;
+  }
+}
+
 template<class B, class S, class R, class IO1>
 template<bi::Location L, class IO2>
 real bi::ParticleFilter<B,S,R,IO1>::filter(Random& rng,
@@ -471,14 +712,15 @@ real bi::ParticleFilter<B,S,R,IO1>::filter(Random& rng,
 
   typename loc_temp_vector<L,real>::type lws(P);
   typename loc_temp_vector<L,int>::type as(P);
+  WeightStatistics stats;
 
   ScheduleIterator iter = first;
   init(rng, *iter, s, lws, as, inInit);
   output0(s);
-  ll = correct(*iter, s, lws);
+  ll = correct(*iter, s, lws, stats);
   output(*iter, s, r, lws, as);
   while (iter + 1 != last) {
-    ll += step(rng, iter, last, s, lws, as);
+    ll += step(rng, iter, last, s, lws, as, stats);
   }
   term();
   outputT(ll);
@@ -500,14 +742,15 @@ real bi::ParticleFilter<B,S,R,IO1>::filter(Random& rng,
 
   typename loc_temp_vector<L,real>::type lws(P);
   typename loc_temp_vector<L,int>::type as(P);
+  WeightStatistics stats;
 
   ScheduleIterator iter = first;
   init(rng, theta, *iter, s, lws, as);
   output0(s);
-  ll = correct(*iter, s, lws);
+  ll = correct(*iter, s, lws, stats);
   output(*iter, s, r, lws, as);
   while (iter + 1 != last) {
-    ll += step(rng, iter, last, s, lws, as);
+    ll += step(rng, iter, last, s, lws, as, stats);
   }
   term();
   outputT(ll);
@@ -529,15 +772,16 @@ real bi::ParticleFilter<B,S,R,IO1>::filter(Random& rng,
 
   typename loc_temp_vector<L,real>::type lws(P);
   typename loc_temp_vector<L,int>::type as(P);
+  WeightStatistics stats;
 
   ScheduleIterator iter = first;
   init(rng, theta, *iter, s, lws, as);
   row(s.getDyn(), 0) = column(X, 0);
   output0(s);
-  ll = correct(*iter, s, lws);
+  ll = correct(*iter, s, lws, stats);
   output(*iter, s, r, lws, as);
   while (iter + 1 != last) {
-    ll += step(rng, iter, last, s, X, lws, as);
+    ll += step(rng, iter, last, s, X, lws, as, stats);
   }
   term();
   outputT(ll);
@@ -592,12 +836,28 @@ template<class B, class S, class R, class IO1>
 template<bi::Location L, class V1, class V2>
 real bi::ParticleFilter<B,S,R,IO1>::step(Random& rng, ScheduleIterator& iter,
     const ScheduleIterator last, State<B,L>& s, V1 lws, V2 as) {
-  bool r = resample(rng, *iter, s, lws, as);
+  WeightStatistics stats;
+  return step(rng, iter, last, s, lws, as, stats);
+}
+
+template<class B, class S, class R, class IO1>
+template<bi::Location L, class V1, class V2>
+real bi::ParticleFilter<B,S,R,IO1>::step(Random& rng, ScheduleIterator& iter,
+    const ScheduleIterator last, State<B,L>& s, V1 lws, V2 as,
+    WeightStatistics& stats) {
+  if (L == ON_HOST && tileSize > 0 && resampler_can_defer_copy<R>::value
+      && as.size() == s.size()) {
+    return stepTiled(rng, iter, last, s, lws, as, stats);
+  }
+
+  bool r = resample(rng, *iter, s, lws, as, stats);
   do {
     ++iter;
+    s.setContinuous(continuous(iter, last));
     predict(rng, *iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
-  real ll = correct(*iter, s, lws);
+  s.setContinuous(false);
+  real ll = correct(*iter, s, lws, stats);
   output(*iter, s, r, lws, as);
 
   return ll;
@@ -607,18 +867,111 @@ template<class B, class S, class R, class IO1>
 template<bi::Location L, class M1, class V1, class V2>
 real bi::ParticleFilter<B,S,R,IO1>::step(Random& rng, ScheduleIterator& iter,
     const ScheduleIterator last, State<B,L>& s, const M1 X, V1 lws, V2 as) {
-  bool r = resample(rng, *iter, s, lws, as);
+  WeightStatistics stats;
+  return step(rng, iter, last, s, X, lws, as, stats);
+}
+
+template<class B, class S, class R, class IO1>
+template<bi::Location L, class M1, class V1, class V2>
+real bi::ParticleFilter<B,S,R,IO1>::step(Random& rng, ScheduleIterator& iter,
+    const ScheduleIterator last, State<B,L>& s, const M1 X, V1 lws, V2 as,
+    WeightStatistics& stats) {
+  bool r = resample(rng, *iter, s, lws, as, stats);
   do {
     ++iter;
+    /* not past output times, where the first particle is overwritten */
+    s.setContinuous(!iter->hasOutput() && continuous(iter, last));
     predict(rng, *iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
+  s.setContinuous(false);
   row(s.getDyn(), 0) = column(X, iter->indexOutput());
-  real ll = correct(*iter, s, lws);
+  real ll = correct(*iter, s, lws, stats);
+  output(*iter, s, r, lws, as);
+
+  return ll;
+}
+
+template<class B, class S, class R, class IO1>
+template<class V1, class V2>
+real bi::ParticleFilter<B,S,R,IO1>::stepTiled(Random& rng,
+    ScheduleIterator& iter, const ScheduleIterator last,
+    State<B,ON_HOST>& s, V1 lws, V2 as, WeightStatistics& stats) {
+  /* pre-conditions */
+  BI_ASSERT(tileSize > 0);
+  BI_ASSERT(s.size() == lws.size());
+  BI_ASSERT(s.size() == as.size());
+
+  const int p = s.start();
+  const int P = s.size();
+  ScheduleIterator iter1;
+  unsigned epoch;
+  int p1, P1;
+
+  bool r = resampleDeferred(rng, *iter, s, lws, as, stats);
+  epoch = rng.getEpoch();
+
+  /* when resampled, tiles are gathered out of place into s1, as the
+   * ancestors of one tile may be in another that has already been
+   * advanced; otherwise tiles are advanced in place */
+  State<B,ON_HOST>& s2 = r ? s1 : s;
+  if (r) {
+    s1.setRange(p, P);
+    s1.getCommon() = s.getCommon();
+  }
+
+  for (p1 = 0; p1 < P; p1 += tileSize) {
+    P1 = bi::min(tileSize, P - p1);
+
+    s2.setRange(p + p1, P1);
+    if (r) {
+      gather_rows(subrange(as, p1, P1), s.getTraj(), s2.getTraj());
+      if (s.getOde().size2() > 0) {
+        s2.resizeOde(s.getOde().size2());
+        gather_rows(subrange(as, p1, P1), s.getOde(), s2.getOde());
+      }
+    }
+
+    /* each tile draws from the same epochs as the whole population would */
+    rng.setEpoch(epoch);
+    iter1 = iter;
+    do {
+      ++iter1;
+      s2.setContinuous(continuous(iter1, last));
+      predict(rng, *iter1, s2);
+    } while (iter1 + 1 != last && !iter1->hasOutput());
+    s2.setContinuous(false);
+
+    if (iter1->hasObs()) {
+      m.observationLogDensities(s2,
+          sim->getObs()->getMask(iter1->indexObs()), subrange(lws, p1, P1));
+    }
+  }
+  s2.setRange(p, P);
+  if (r) {
+    s.swap(s1);
+  }
+  iter = iter1;
+
+  /* same reduction as correct() */
+  real ll = 0.0;
+  if (iter->hasObs()) {
+    stats.update(lws);
+    ll = stats.logSum() - bi::log(static_cast<real>(P));
+  }
   output(*iter, s, r, lws, as);
 
   return ll;
 }
 
+template<class B, class S, class R, class IO1>
+template<bi::Location L, class V1, class V2>
+real bi::ParticleFilter<B,S,R,IO1>::stepTiled(Random& rng,
+    ScheduleIterator& iter, const ScheduleIterator last, State<B,L>& s,
+    V1 lws, V2 as, WeightStatistics& stats) {
+  BI_ASSERT_MSG(false, "Tiled step not supported on device");
+  return 0.0;
+}
+
 template<class B, class S, class R, class IO1>
 template<bi::Location L>
 void bi::ParticleFilter<B,S,R,IO1>::predict(Random& rng,
@@ -626,17 +979,33 @@ void bi::ParticleFilter<B,S,R,IO1>::predict(Random& rng,
   sim->advance(rng, next, s);
 }
 
+template<class B, class S, class R, class IO1>
+bool bi::ParticleFilter<B,S,R,IO1>::continuous(const ScheduleIterator iter,
+    const ScheduleIterator last) {
+  return iter + 1 != last && !iter->hasObs() && !iter->hasDelta() &&
+      !(iter + 1)->hasDelta() && !(iter + 1)->hasInput();
+}
+
 template<class B, class S, class R, class IO1>
 template<bi::Location L, class V1>
 real bi::ParticleFilter<B,S,R,IO1>::correct(const ScheduleElement now,
     State<B,L>& s, V1 lws) {
+  WeightStatistics stats;
+  return correct(now, s, lws, stats);
+}
+
+template<class B, class S, class R, class IO1>
+template<bi::Location L, class V1>
+real bi::ParticleFilter<B,S,R,IO1>::correct(const ScheduleElement now,
+    State<B,L>& s, V1 lws, WeightStatistics& stats) {
   /* pre-condition */
   BI_ASSERT(s.size() == lws.size());
 
   real ll = 0.0;
   if (now.hasObs()) {
     m.observationLogDensities(s, sim->getObs()->getMask(now.indexObs()), lws);
-    ll = logsumexp_reduce(lws) - bi::log(static_cast<real>(s.size()));
+    stats.update(lws);
+    ll = stats.logSum() - bi::log(static_cast<real>(s.size()));
   }
   return ll;
 }
@@ -644,11 +1013,15 @@ real bi::ParticleFilter<B,S,R,IO1>::correct(const ScheduleElement now,
 template<class B, class S, class R, class IO1>
 template<bi::Location L, class V1, class V2>
 bool bi::ParticleFilter<B,S,R,IO1>::resample(Random& rng,
-    const ScheduleElement now, State<B,L>& s, V1 lws, V2 as) {
+    const ScheduleElement now, State<B,L>& s, V1 lws, V2 as,
+    WeightStatistics& stats) {
   /* pre-condition */
   BI_ASSERT(s.size() == lws.size());
 
-  bool r = now.hasObs() && resam != NULL && resam->isTriggered(lws);
+  if (!stats.isValid()) {
+    stats.update(lws);
+  }
+  bool r = now.hasObs() && resam != NULL && resam->isTriggered(lws, stats);
   if (r) {
     if (resampler_needs_max<R>::value) {
       resam->setMaxLogWeight(
@@ -658,8 +1031,10 @@ bool bi::ParticleFilter<B,S,R,IO1>::resample(Random& rng,
     resam->resample(rng, lws, as, s);
   } else {
     seq_elements(as, 0);
-    Resampler::normalise(lws);
+    Resampler::normalise(lws, stats);
   }
+  stats.invalidate();
+
   return r;
 }
 
@@ -671,7 +1046,9 @@ bool bi::ParticleFilter<B,S,R,IO1>::resample(Random& rng,
   BI_ASSERT(s.size() == lws.size());
   BI_ASSERT(a == 0);
 
-  bool r = now.hasObs() && resam != NULL && resam->isTriggered(lws);
+  WeightStatistics stats;
+  stats.update(lws);
+  bool r = now.hasObs() && resam != NULL && resam->isTriggered(lws, stats);
   if (r) {
     if (resampler_needs_max<R>::value) {
       resam->setMaxLogWeight(
@@ -681,8 +1058,37 @@ bool bi::ParticleFilter<B,S,R,IO1>::resample(Random& rng,
     resam->cond_resample(rng, a, a, lws, as, s);
   } else {
     seq_elements(as, 0);
-    Resampler::normalise(lws);
+    Resampler::normalise(lws, stats);
+  }
+  return r;
+}
+
+template<class B, class S, class R, class IO1>
+template<bi::Location L, class V1, class V2>
+bool bi::ParticleFilter<B,S,R,IO1>::resampleDeferred(Random& rng,
+    const ScheduleElement now, State<B,L>& s, V1 lws, V2 as,
+    WeightStatistics& stats) {
+  /* pre-condition */
+  BI_ASSERT(s.size() == lws.size());
+
+  if (!stats.isValid()) {
+    stats.update(lws);
+  }
+  bool r = now.hasObs() && resam != NULL && resam->isTriggered(lws, stats);
+  if (r) {
+    if (resampler_needs_max<R>::value) {
+      resam->setMaxLogWeight(
+          m.observationMaxLogDensity(s,
+              sim->getObs()->getMask(now.indexObs())));
+    }
+    resample_deferred_impl<resampler_can_defer_copy<R>::value>::func(rng,
+        resam, lws, as);
+  } else {
+    seq_elements(as, 0);
+    Resampler::normalise(lws, stats);
   }
+  stats.invalidate();
+
   return r;
 }
 
@@ -718,4 +1124,18 @@ void bi::ParticleFilter<B,S,R,IO1>::term() {
   sim->term();
 }
 
+template<bool defer>
+template<class R, class V1, class V2>
+void bi::resample_deferred_impl<defer>::func(Random& rng, R* resam, V1 lws,
+    V2 as) {
+  DeferredCopy s;
+  resam->resample(rng, lws, as, s);
+}
+
+template<class R, class V1, class V2>
+void bi::resample_deferred_impl<false>::func(Random& rng, R* resam, V1 lws,
+    V2 as) {
+  BI_ASSERT_MSG(false, "Resampler does not support deferred copy");
+}
+
 #endif
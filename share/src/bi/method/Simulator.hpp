@@ -395,6 +395,7 @@ void bi::Simulator<B,F,O,IO1>::simulate(Random& rng,
   while (iter + 1 != last) {
     step(rng, iter, last, s);
   }
+  s.setContinuous(false);
   term();
 }
 
@@ -411,6 +412,7 @@ void bi::Simulator<B,F,O,IO1>::simulate(const ScheduleIterator first,
   while (iter + 1 != last) {
     step(iter, last, s);
   }
+  s.setContinuous(false);
   term();
 }
 
@@ -418,6 +420,9 @@ template<class B, class F, class O, class IO1>
 template<bi::Location L, class IO2>
 void bi::Simulator<B,F,O,IO1>::init(Random& rng, const ScheduleElement now,
     State<B,L>& s, IO2* inInit) {
+  /* integrator state, so that step sizes are kept within a run only */
+  s.getOde().clear();
+
   /* static inputs */
   if (in != NULL) {
     in->update0(s);
@@ -466,6 +471,9 @@ template<class B, class F, class O, class IO1>
 template<bi::Location L, class IO2>
 void bi::Simulator<B,F,O,IO1>::init(const ScheduleElement now, State<B,L>& s,
     IO2* inInit) {
+  /* integrator state, so that step sizes are kept within a run only */
+  s.getOde().clear();
+
   /* static inputs */
   if (in != NULL) {
     in->update0(s);
@@ -515,6 +523,9 @@ void bi::Simulator<B,F,O,IO1>::init(Random& rng, const V1 theta,
   /* pre-condition */
   BI_ASSERT(theta.size() == B::NP);
 
+  /* integrator state, so that step sizes are kept within a run only */
+  s.getOde().clear();
+
   /* static inputs */
   if (in != NULL) {
     in->update0(s);
@@ -546,6 +557,9 @@ void bi::Simulator<B,F,O,IO1>::init(const V1 theta, const ScheduleElement now,
   /* pre-condition */
   BI_ASSERT(theta.size() == B::NP);
 
+  /* integrator state, so that step sizes are kept within a run only */
+  s.getOde().clear();
+
   /* static inputs */
   if (in != NULL) {
     in->update0(s);
@@ -576,6 +590,10 @@ void bi::Simulator<B,F,O,IO1>::step(Random& rng, ScheduleIterator& iter,
     const ScheduleIterator last, State<B,L>& s) {
   do {
     ++iter;
+    /* integrators may step past the end of the interval if nothing but
+     * them changes the state there */
+    s.setContinuous(iter + 1 != last && !iter->hasDelta() &&
+        !(iter + 1)->hasDelta() && !(iter + 1)->hasInput());
     advance(rng, *iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
   output(*iter, s);
@@ -587,6 +605,10 @@ void bi::Simulator<B,F,O,IO1>::step(ScheduleIterator& iter,
     const ScheduleIterator last, State<B,L>& s) {
   do {
     ++iter;
+    /* integrators may step past the end of the interval if nothing but
+     * them changes the state there */
+    s.setContinuous(iter + 1 != last && !iter->hasDelta() &&
+        !(iter + 1)->hasDelta() && !(iter + 1)->hasInput());
     advance(*iter, s);
   } while (iter + 1 != last && !iter->hasOutput());
   output(*iter, s);
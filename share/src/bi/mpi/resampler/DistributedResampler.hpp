@@ -44,6 +44,16 @@ public:
   bool isTriggered(const V1 lws) const
       throw (ParticleFilterDegeneratedException);
 
+  /**
+   * @copydoc Resampler::isTriggered
+   *
+   * The statistics are local to this process, so are not used; the ESS is
+   * computed across all processes as in isTriggered(const V1) const.
+   */
+  template<class V1>
+  bool isTriggered(const V1 lws, const WeightStatistics& stats) const
+      throw (ParticleFilterDegeneratedException);
+
   /**
    * @copydoc Resampler::ess
    */
@@ -200,6 +210,14 @@ bool bi::DistributedResampler<R>::isTriggered(const V1 lws) const
   return essRel >= 1.0 || ess(lws) < essRel * size * P;
 }
 
+template<class R>
+template<class V1>
+bool bi::DistributedResampler<R>::isTriggered(const V1 lws,
+    const WeightStatistics& stats) const
+    throw (ParticleFilterDegeneratedException) {
+  return isTriggered(lws);
+}
+
 template<class R>
 template<class V1>
 typename V1::value_type bi::DistributedResampler<R>::ess(const V1 lws)
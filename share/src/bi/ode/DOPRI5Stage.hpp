@@ -21,11 +21,15 @@ namespace bi {
  * @tparam CX Coordinates type.
  * @tparam PX Parents type.
  * @tparam T2 Scalar type.
+ *
+ * Alongside the error estimate @c err, the stages accumulate in @c dense the
+ * last coefficient of the continuous extension of @ref Hairer1993
+ * "Hairer, Norsett & Wanner (1993)", which is missing a factor of @c h.
  */
 template<class X, class T1, class B, Location L, class CX, class PX, class T2>
 class DOPRI5Stage {
 public:
-  static CUDA_FUNC_BOTH void stage1(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, const bool k1in = false) {
+  static CUDA_FUNC_BOTH void stage1(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x1, T2& x2, T2& x3, T2& x4, T2& x5, T2& x6, T2& k1, T2& err, T2& dense, const bool k1in = false) {
     const T1 a21 = BI_REAL(0.2);
     const T1 a31 = BI_REAL(3.0/40.0);
     const T1 a41 = BI_REAL(44.0/45.0);
@@ -33,6 +37,7 @@ public:
     const T1 a61 = BI_REAL(9017.0/3168.0);
     const T1 a71 = BI_REAL(35.0/384.0);
     const T1 e1 = BI_REAL(71.0/57600.0);
+    const T1 d1 = BI_REAL(-12715105075.0/11282082432.0);
 
     if (!k1in) {
       X::dfdt(t, s, p, cox, pax, k1);
@@ -45,6 +50,7 @@ public:
     x5 = a61*k1;
     x6 = a71*k1;
     err = e1*k1;
+    dense = d1*k1;
 
     x1 = h*x1 + x0;
   }
@@ -67,13 +73,14 @@ public:
     x2 = h*x2 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage3(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_BOTH void stage3(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x3, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     const T1 c3 = BI_REAL(0.3);
     const T1 a43 = BI_REAL(32.0/9.0);
     const T1 a53 = BI_REAL(64448.0/6561.0);
     const T1 a63 = BI_REAL(46732.0/5247.0);
     const T1 a73 = BI_REAL(500.0/1113.0);
     const T1 e3 = BI_REAL(-71.0/16695.0);
+    const T1 d3 = BI_REAL(87487479700.0/32700410799.0);
 
     T2 k3;
     X::dfdt(t + c3*h, s, p, cox, pax, k3);
@@ -83,16 +90,18 @@ public:
     x5 += a63*k3;
     x6 += a73*k3;
     err += e3*k3;
+    dense += d3*k3;
 
     x3 = h*x3 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage4(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x4, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_BOTH void stage4(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x4, T2& x5, T2& x6, T2& err, T2& dense) {
     const T1 c4 = BI_REAL(0.8);
     const T1 a54 = BI_REAL(-212.0/729.0);
     const T1 a64 = BI_REAL(49.0/176.0);
     const T1 a74 = BI_REAL(125.0/192.0);
     const T1 e4 = BI_REAL(71.0/1920.0);
+    const T1 d4 = BI_REAL(-10690763975.0/1880347072.0);
 
     T2 k4;
     X::dfdt(t + c4*h, s, p, cox, pax, k4);
@@ -101,15 +110,17 @@ public:
     x5 += a64*k4;
     x6 += a74*k4;
     err += e4*k4;
+    dense += d4*k4;
 
     x4 = h*x4 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage5(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x5, T2& x6, T2& err) {
+  static CUDA_FUNC_BOTH void stage5(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x5, T2& x6, T2& err, T2& dense) {
     const T1 c5 = BI_REAL(8.0/9.0);
     const T1 a65 = BI_REAL(-5103.0/18656.0);
     const T1 a75 = BI_REAL(-2187.0/6784.0);
     const T1 e5 = BI_REAL(-17253.0/339200.0);
+    const T1 d5 = BI_REAL(701980252875.0/199316789632.0);
 
     T2 k5;
     X::dfdt(t + c5*h, s, p, cox, pax, k5);
@@ -117,29 +128,34 @@ public:
     x5 += a65*k5;
     x6 += a75*k5;
     err += e5*k5;
+    dense += d5*k5;
 
     x5 = h*x5 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stage6(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x6, T2& err) {
+  static CUDA_FUNC_BOTH void stage6(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, T2& x6, T2& err, T2& dense) {
     const T1 a76 = BI_REAL(11.0/84.0);
     const T1 e6 = BI_REAL(22.0/525.0);
+    const T1 d6 = BI_REAL(-1453857185.0/822651844.0);
 
     T2 k6;
     X::dfdt(t + h, s, p, cox, pax, k6);
 
     x6 += a76*k6;
     err += e6*k6;
+    dense += d6*k6;
 
     x6 = h*x6 + x0;
   }
 
-  static CUDA_FUNC_BOTH void stageErr(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, const T2 x1, T2& k7, T2& err) {
+  static CUDA_FUNC_BOTH void stageErr(const T1 t, const T1 h, const State<B,L>& s, const int p, const CX& cox, const PX& pax, const T2 x0, const T2 x1, T2& k7, T2& err, T2& dense) {
     const T1 e7 = BI_REAL(-1.0/40.0);
+    const T1 d7 = BI_REAL(69997945.0/29380423.0);
 
     X::dfdt(t + h, s, p, cox, pax, k7);
 
     err += e7*k7;
+    dense += d7*k7;
   }
 };
 
@@ -36,7 +36,9 @@ public:
 }
 
 #include "../host/ode/RK43IntegratorHost.hpp"
-#ifdef ENABLE_SSE
+#if defined(ENABLE_AVX)
+#include "../avx/ode/RK43IntegratorAVX.hpp"
+#elif defined(ENABLE_SSE)
 #include "../sse/ode/RK43IntegratorSSE.hpp"
 #endif
 #ifdef __CUDACC__
@@ -51,12 +53,11 @@ void bi::RK43Integrator<B,S>::update(const T1 t1, const T1 t2,
   BI_ASSERT(t1 <= t2);
 
   if (bi::abs(t2 - t1) > 0.0) {
-    #ifdef ENABLE_SSE
-    if (s.size() % BI_SSE_SIZE == 0) {
-      RK43IntegratorSSE<B,S,T1>::update(t1, t2, s);
-    } else {
-      RK43IntegratorHost<B,S,T1>::update(t1, t2, s);
-    }
+    /* lanes refill from a queue of trajectories, so no scalar tail */
+    #if defined(ENABLE_AVX)
+    RK43IntegratorAVX<B,S,T1>::update(t1, t2, s);
+    #elif defined(ENABLE_SSE)
+    RK43IntegratorSSE<B,S,T1>::update(t1, t2, s);
     #else
     RK43IntegratorHost<B,S,T1>::update(t1, t2, s);
     #endif
@@ -51,11 +51,18 @@ void bi::RK4Integrator<B,S>::update(const T1 t1, const T1 t2,
 
   if (bi::abs(t2 - t1) > 0.0) {
     #ifdef ENABLE_SSE
-    if (s.size() % BI_SSE_SIZE == 0) {
+    const int p = s.start(), P = s.size(), P1 = sse_host_size(s);
+
+    /* SSE over whole vectors, scalar over any remaining tail */
+    if (P1 > 0) {
+      s.setRange(p, P1);
       RK4IntegratorSSE<B,S,T1>::update(t1, t2, s);
-    } else {
+    }
+    if (P1 < P) {
+      s.setRange(p + P1, P - P1);
       RK4IntegratorHost<B,S,T1>::update(t1, t2, s);
     }
+    s.setRange(p, P);
     #else
     RK4IntegratorHost<B,S,T1>::update(t1, t2, s);
     #endif
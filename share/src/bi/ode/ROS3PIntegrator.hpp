@@ -0,0 +1,61 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_ODE_ROS3PINTEGRATOR_HPP
+#define BI_ODE_ROS3PINTEGRATOR_HPP
+
+#include "../misc/location.hpp"
+#include "../state/State.hpp"
+
+namespace bi {
+/**
+ * Update using ROS3P linearly implicit Rosenbrock integrator with adaptive
+ * step-size control, for stiff systems.
+ *
+ * @ingroup method_updater
+ *
+ * @tparam B Model type.
+ * @tparam S Action type list.
+ */
+template<class B, class S>
+class ROS3PIntegrator {
+public:
+  template<class T1>
+  static void update(const T1 t1, const T1 t2, State<B,ON_HOST>& s);
+
+  #ifdef __CUDACC__
+  template<class T1>
+  static void update(const T1 t1, const T1 t2, State<B,ON_DEVICE>& s);
+  #endif
+};
+
+}
+
+#include "../host/ode/ROS3PIntegratorHost.hpp"
+
+template<class B, class S>
+template<class T1>
+void bi::ROS3PIntegrator<B,S>::update(const T1 t1, const T1 t2,
+    State<B,ON_HOST>& s) {
+  /* pre-conditions */
+  BI_ASSERT(t1 <= t2);
+
+  if (bi::abs(t2 - t1) > 0.0) {
+    ROS3PIntegratorHost<B,S,T1>::update(t1, t2, s);
+  }
+}
+
+#ifdef __CUDACC__
+template<class B, class S>
+template<class T1>
+void bi::ROS3PIntegrator<B,S>::update(const T1 t1, const T1 t2,
+    State<B,ON_DEVICE>& s) {
+  BI_ERROR_MSG(false, "ROS3P not implemented for device");
+}
+#endif
+
+#endif
@@ -13,11 +13,12 @@
 namespace bi {
 /**
  * Allocator for aligned memory. Useful to align buffers for ready loading
- * of SSE 128-bit values.
+ * of SSE 128-bit values. The default alignment is that of a cache line,
+ * which suffices also for wider vector registers (see BI_STATE_ALIGN).
  *
  * @ingroup primitive_allocators
  */
-template <class T, unsigned X = 16>
+template <class T, unsigned X = 64>
 class aligned_allocator {
 public:
   typedef size_t size_type;
@@ -15,6 +15,7 @@
 #define BI_PRIMITIVE_VECTORPRIMITIVE_HPP
 
 #include "functor.hpp"
+#include "../misc/location.hpp"
 
 #include "thrust/functional.h"
 
@@ -44,6 +45,16 @@ typename V1::value_type op_reduce(const V1 x, UnaryFunctor op1,
     const typename V1::value_type init,
     BinaryFunctor op2 = thrust::plus<typename V1::value_type>());
 
+/**
+ * @internal
+ */
+template<Location L>
+struct op_reduce_impl {
+  template<class V1, class UnaryFunctor, class BinaryFunctor>
+  static typename V1::value_type func(const V1 x, UnaryFunctor op1,
+      const typename V1::value_type init, BinaryFunctor op2);
+};
+
 /**
  * Sum reduction.
  *
@@ -114,6 +125,15 @@ typename V1::value_type min_reduce(const V1 x);
 template<class V1>
 typename V1::value_type max_reduce(const V1 x);
 
+/**
+ * @internal
+ */
+template<Location L>
+struct max_reduce_impl {
+  template<class V1>
+  static typename V1::value_type func(const V1 x);
+};
+
 /**
  * Minimum absolute value reduction
  *
@@ -168,6 +188,15 @@ typename V1::value_type sumexp_reduce(const V1 x);
 template<class V1>
 typename V1::value_type logsumexp_reduce(const V1 x);
 
+/**
+ * @internal
+ */
+template<Location L>
+struct logsumexp_reduce_impl {
+  template<class V1>
+  static typename V1::value_type func(const V1 x);
+};
+
 /**
  * Sum-exp-square reduction.
  *
@@ -195,6 +224,45 @@ typename V1::value_type sumexpsq_reduce(const V1 x);
 template<class V1>
 typename V1::value_type ess_reduce(const V1 lws);
 
+/**
+ * @internal
+ */
+template<Location L>
+struct ess_reduce_impl {
+  template<class V1>
+  static typename V1::value_type func(const V1 lws);
+};
+
+/**
+ * Weight statistics reduction.
+ *
+ * @ingroup primitive_vector
+ *
+ * @param lws \f$\log \mathbf{w}\f$; log-weights.
+ * @param[out] mx Maximum log-weight.
+ * @param[out] sum1 Sum of weights, relative to the maximum.
+ * @param[out] sum2 Sum of squared weights, relative to the maximum.
+ *
+ * Computes \f$m = \max(\log\mathbf{w})\f$, \f$\sum_i \exp(\log w_i -
+ * m)\f$ and \f$\sum_i \exp(\log w_i - m)^2\f$, from which both
+ * logsumexp_reduce() and ess_reduce() follow, with a single pass over the
+ * log-weights where the location permits. NaN values do not contribute to
+ * the sums.
+ */
+template<class V1>
+void weight_stats_reduce(const V1 lws, typename V1::value_type& mx,
+    typename V1::value_type& sum1, typename V1::value_type& sum2);
+
+/**
+ * @internal
+ */
+template<Location L>
+struct weight_stats_reduce_impl {
+  template<class V1>
+  static void func(const V1 lws, typename V1::value_type& mx,
+      typename V1::value_type& sum1, typename V1::value_type& sum2);
+};
+
 //@}
 
 /**
@@ -222,6 +290,16 @@ void op_exclusive_scan(const V1 x, V2 y, const typename V1::value_type init,
     UnaryFunctor op1 = thrust::identity<typename V1::value_type>(),
     BinaryFunctor op2 = thrust::plus<typename V1::value_type>());
 
+/**
+ * @internal
+ */
+template<Location L>
+struct op_exclusive_scan_impl {
+  template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+  static void func(const V1 x, V2 y, const typename V1::value_type init,
+      UnaryFunctor op1, BinaryFunctor op2);
+};
+
 /**
  * Apply inclusive scan across a vector.
  *
@@ -241,6 +319,15 @@ template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
 void op_inclusive_scan(const V1 x, V2 y, UnaryFunctor op1, BinaryFunctor op2 =
     thrust::plus<typename V1::value_type>());
 
+/**
+ * @internal
+ */
+template<Location L>
+struct op_inclusive_scan_impl {
+  template<class V1, class V2, class UnaryFunctor, class BinaryFunctor>
+  static void func(const V1 x, V2 y, UnaryFunctor op1, BinaryFunctor op2);
+};
+
 /**
  * Exclusive scan-sum.
  *
@@ -737,6 +824,8 @@ bool equal(const V1 input1, const V1 input2);
 
 }
 
+#include "../host/primitive/vector_primitive.hpp"
+
 #include "thrust/extrema.h"
 #include "thrust/transform_reduce.h"
 #include "thrust/transform_scan.h"
@@ -755,6 +844,13 @@ bool equal(const V1 input1, const V1 input2);
 template<class V1, class UnaryFunctor, class BinaryFunctor>
 typename V1::value_type bi::op_reduce(const V1 x, UnaryFunctor op1,
     const typename V1::value_type init, BinaryFunctor op2) {
+  return op_reduce_impl<V1::location>::func(x, op1, init, op2);
+}
+
+template<bi::Location L>
+template<class V1, class UnaryFunctor, class BinaryFunctor>
+typename V1::value_type bi::op_reduce_impl<L>::func(const V1 x,
+    UnaryFunctor op1, const typename V1::value_type init, BinaryFunctor op2) {
   if (x.inc() == 1) {
     return thrust::transform_reduce(x.fast_begin(), x.fast_end(), op1, init,
         op2);
@@ -815,6 +911,12 @@ inline typename V1::value_type bi::max_reduce(const V1 x) {
   /* pre-condition */
   BI_ASSERT(x.size() > 0);
 
+  return max_reduce_impl<V1::location>::func(x);
+}
+
+template<bi::Location L>
+template<class V1>
+typename V1::value_type bi::max_reduce_impl<L>::func(const V1 x) {
   typedef typename V1::value_type T1;
   if (x.inc() == 1) {
     return *thrust::max_element(x.fast_begin(), x.fast_end(),
@@ -884,6 +986,12 @@ inline typename V1::value_type bi::sumexp_reduce(const V1 x) {
 
 template<class V1>
 inline typename V1::value_type bi::logsumexp_reduce(const V1 x) {
+  return logsumexp_reduce_impl<V1::location>::func(x);
+}
+
+template<bi::Location L>
+template<class V1>
+typename V1::value_type bi::logsumexp_reduce_impl<L>::func(const V1 x) {
   typedef typename V1::value_type T1;
 
   T1 mx = max_reduce(x);
@@ -914,6 +1022,12 @@ inline typename V1::value_type bi::ess_reduce(const V1 lws) {
   /* pre-condition */
   BI_ASSERT(lws.size() > 0);
 
+  return ess_reduce_impl<V1::location>::func(lws);
+}
+
+template<bi::Location L>
+template<class V1>
+typename V1::value_type bi::ess_reduce_impl<L>::func(const V1 lws) {
   typedef typename V1::value_type T1;
 
   T1 mx = max_reduce(lws);
@@ -925,12 +1039,44 @@ inline typename V1::value_type bi::ess_reduce(const V1 lws) {
   return (sum1 * sum1) / sum2;
 }
 
+template<class V1>
+inline void bi::weight_stats_reduce(const V1 lws,
+    typename V1::value_type& mx, typename V1::value_type& sum1,
+    typename V1::value_type& sum2) {
+  /* pre-condition */
+  BI_ASSERT(lws.size() > 0);
+
+  weight_stats_reduce_impl<V1::location>::func(lws, mx, sum1, sum2);
+}
+
+template<bi::Location L>
+template<class V1>
+void bi::weight_stats_reduce_impl<L>::func(const V1 lws,
+    typename V1::value_type& mx, typename V1::value_type& sum1,
+    typename V1::value_type& sum2) {
+  typedef typename V1::value_type T1;
+
+  mx = max_reduce(lws);
+  sum1 = op_reduce(lws, nan_minus_and_exp_functor<T1>(mx), 0.0,
+      thrust::plus<T1>());
+  sum2 = op_reduce(lws, nan_minus_exp_and_square_functor<T1>(mx), 0.0,
+      thrust::plus<T1>());
+}
+
 template<class V1, class V2, class UnaryOperator, class BinaryOperator>
 void bi::op_exclusive_scan(const V1 x, V2 y, typename V1::value_type init,
     UnaryOperator op1, BinaryOperator op2) {
   /* pre-conditions */
   BI_ASSERT(x.size() == y.size());
 
+  op_exclusive_scan_impl<V2::location>::func(x, y, init, op1, op2);
+}
+
+template<bi::Location L>
+template<class V1, class V2, class UnaryOperator, class BinaryOperator>
+void bi::op_exclusive_scan_impl<L>::func(const V1 x, V2 y,
+    const typename V1::value_type init, UnaryOperator op1,
+    BinaryOperator op2) {
   if (x.inc() == 1 && y.inc() == 1) {
     thrust::transform_exclusive_scan(x.fast_begin(), x.fast_end(),
         y.fast_begin(), op1, init, op2);
@@ -946,6 +1092,13 @@ void bi::op_inclusive_scan(const V1 x, V2 y, UnaryOperator op1,
   /* pre-conditions */
   BI_ASSERT(x.size() == y.size());
 
+  op_inclusive_scan_impl<V2::location>::func(x, y, op1, op2);
+}
+
+template<bi::Location L>
+template<class V1, class V2, class UnaryOperator, class BinaryOperator>
+void bi::op_inclusive_scan_impl<L>::func(const V1 x, V2 y,
+    UnaryOperator op1, BinaryOperator op2) {
   if (x.inc() == 1 && y.inc() == 1) {
     thrust::transform_inclusive_scan(x.fast_begin(), x.fast_end(),
         y.fast_begin(), op1, op2);
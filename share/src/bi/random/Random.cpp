@@ -11,7 +11,7 @@
 #include "../cuda/device.hpp"
 #endif
 
-bi::Random::Random() : own(true) {
+bi::Random::Random() : own(true), epoch(0) {
   hostRngs = new RngHost[bi_omp_max_threads];
   #ifdef ENABLE_CUDA
   CUDA_CHECKED_CALL(cudaMalloc(&devRngs,
@@ -19,7 +19,7 @@ bi::Random::Random() : own(true) {
   #endif
 }
 
-bi::Random::Random(const unsigned seed) : own(true) {
+bi::Random::Random(const unsigned seed) : own(true), epoch(0) {
   hostRngs = new RngHost[bi_omp_max_threads];
   #ifdef ENABLE_CUDA
   CUDA_CHECKED_CALL(cudaMalloc(&devRngs,
@@ -34,6 +34,7 @@ bi::Random::Random(const Random& o) {
   devRngs = o.devRngs;
   #endif
   own = false;
+  epoch = o.epoch;
 }
 
 bi::Random::~Random() {
@@ -48,6 +49,7 @@ bi::Random::~Random() {
 }
 
 void bi::Random::seeds(const unsigned seed) {
+  epoch = 0;
   RandomHost::seeds(*this, seed);
   #ifdef ENABLE_CUDA
   RandomGPU::seeds(*this, seed);
@@ -42,6 +42,13 @@ namespace bi {
  * variable before it is copied back to global memory with #setDevRng.
  *
  * Internally, the plural methods take this approach.
+ *
+ * When compiled with <tt>ENABLE_PHILOX</tt>, the host PRNGs are
+ * counter-based. Each call to a plural method, or to a sampler that
+ * uses #nextEpoch, starts a new epoch, and the variates for each
+ * particle, or each block of #BI_RNG_BATCH_SIZE elements, are drawn from
+ * a substream keyed by its index and that epoch, so that results do not
+ * depend on the number of threads.
  */
 class Random {
 public:
@@ -249,6 +256,30 @@ public:
    */
   RngHost& getHostRng();
 
+  /**
+   * Start a new epoch, for use with RngHost::seek(). Must be called from
+   * outside of any parallel region, and the same number of times in every
+   * run for results to be reproducible.
+   *
+   * @return The new epoch.
+   */
+  unsigned nextEpoch();
+
+  /**
+   * Get the current epoch.
+   */
+  unsigned getEpoch() const;
+
+  /**
+   * Return to an earlier epoch, so that the variates of its following
+   * epochs are drawn again, as when the same step is repeated for separate
+   * subsets of particles. Must be called from outside of any parallel
+   * region.
+   *
+   * @param epoch Epoch, as returned by #getEpoch.
+   */
+  void setEpoch(const unsigned epoch);
+
 #ifdef ENABLE_CUDA
   /**
    * Get a thread's random number generator.
@@ -278,6 +309,11 @@ public:
    * launch, the random number generators are not destroyed on exit.
    */
   bool own;
+
+  /**
+   * Current epoch.
+   */
+  unsigned epoch;
 };
 }
 
@@ -373,6 +409,18 @@ inline bi::RngHost& bi::Random::getHostRng() {
   return hostRngs[bi_omp_tid];
 }
 
+inline unsigned bi::Random::nextEpoch() {
+  return ++epoch;
+}
+
+inline unsigned bi::Random::getEpoch() const {
+  return epoch;
+}
+
+inline void bi::Random::setEpoch(const unsigned epoch) {
+  this->epoch = epoch;
+}
+
 #ifdef ENABLE_CUDA
 inline curandState& bi::Random::getDevRng(const int p) {
   return devRngs[p];
@@ -35,6 +35,10 @@
  * Hairer, E.; Norsett, S. N. & Wanner, G. Solving Ordinary Differential
  * Equations I: Nonstiff Problems. Springer-Verlag, <b>1993</b>.
  *
+ * @anchor Hairer1996
+ * Hairer, E. & Wanner, G. Solving Ordinary Differential Equations II: Stiff
+ * and Differential-Algebraic Problems. Springer-Verlag, <b>1996</b>.
+ *
  * @anchor Jones2010
  * Jones, E.; Parslow, J. & Murray, L. A Bayesian approach to state and
  * parameter estimation in a Phytoplankton-Zooplankton model. <i>Australian
@@ -50,6 +54,11 @@
  * Nonlinear %State Space Models. <i>Journal of Computational and
  * Graphical Statistics</i>, <b>1996</b>, 5, 1-25.
  *
+ * @anchor Lang2001
+ * Lang, J. & Verwer, J. ROS3P---An accurate third-order Rosenbrock solver
+ * designed for parabolic problems. <i>BIT Numerical Mathematics</i>,
+ * <b>2001</b>, 41, 731-738.
+ *
  * @anchor Marsaglia2000
  * Marsaglia, G. & Tsang, W. W. A Simple Method for Generating Gamma
  * Variables. <i>ACM Transactions on Mathematical Software</i>, <b>2000</b>,
@@ -143,6 +143,15 @@ private:
    */
   int B;
 };
+
+/**
+ * @internal
+ */
+template<>
+struct resampler_can_defer_copy<MetropolisResampler> {
+  static const bool value = true;
+};
+
 }
 
 #include "../host/resampler/MetropolisResamplerHost.hpp"
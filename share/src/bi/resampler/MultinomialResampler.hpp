@@ -147,6 +147,14 @@ struct precompute_type<MultinomialResampler,L> {
   typedef MultinomialPrecompute<L> type;
 };
 
+/**
+ * @internal
+ */
+template<>
+struct resampler_can_defer_copy<MultinomialResampler> {
+  static const bool value = true;
+};
+
 }
 
 #include "../host/resampler/MultinomialResamplerHost.hpp"
@@ -95,6 +95,13 @@ public:
   bool isTriggered(const V1 lws) const
       throw (ParticleFilterDegeneratedException);
 
+  /**
+   * @copydoc isTriggered(const V1) const
+   */
+  template<class V1>
+  bool isTriggered(const V1 lws, const WeightStatistics& stats) const
+      throw (ParticleFilterDegeneratedException);
+
   /**
    * @copydoc concept::Resampler::resample(Random&, V1, V2, O1&)
    */
@@ -173,6 +180,14 @@ struct resampler_needs_max<RejectionResampler> {
   static const bool value = true;
 };
 
+/**
+ * @internal
+ */
+template<>
+struct resampler_can_defer_copy<RejectionResampler> {
+  static const bool value = true;
+};
+
 }
 
 #include "../host/resampler/RejectionResamplerHost.hpp"
@@ -186,6 +201,13 @@ bool bi::RejectionResampler::isTriggered(const V1 lws) const
   return true;
 }
 
+template<class V1>
+bool bi::RejectionResampler::isTriggered(const V1 lws,
+    const WeightStatistics& stats) const
+    throw (ParticleFilterDegeneratedException) {
+  return true;
+}
+
 template<class V1, class V2, class O1>
 void bi::RejectionResampler::resample(Random& rng, V1 lws, V2 as, O1& s) {
   /* pre-condition */
@@ -13,6 +13,7 @@
 #include "../misc/exception.hpp"
 #include "../misc/location.hpp"
 #include "../traits/resampler_traits.hpp"
+#include "WeightStatistics.hpp"
 
 namespace bi {
 /**
@@ -59,6 +60,22 @@ struct resample_error: public std::binary_function<T,int,T> {
   }
 };
 
+/**
+ * Stand-in for a state when resampling, where the in-place copy of
+ * particles is deferred to the caller.
+ *
+ * @ingroup method_resampler
+ *
+ * Passing a DeferredCopy to the resample() member function of a resampler
+ * for which #resampler_can_defer_copy is true computes ancestors and
+ * adjusts log-weights exactly as usual, but leaves the copy of particles
+ * to the caller, who may then fuse it with subsequent operations (see
+ * ParticleFilter::setTileSize()).
+ */
+struct DeferredCopy {
+  //
+};
+
 /**
  * %Resampler for particle filter.
  *
@@ -211,6 +228,9 @@ public:
    *
    * @param as Ancestry.
    * @param[in,out] s State.
+   *
+   * The state of adaptive ODE integrators, such as step sizes, is copied
+   * along with that of the model.
    */
   template<class V1, class B, Location L>
   static void copy(const V1 as, State<B,L>& s);
@@ -227,6 +247,17 @@ public:
   template<class V1, class T1>
   static void copy(const V1 as, std::vector<T1*>& v);
 
+  /**
+   * Deferred copy, does nothing.
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param as Ancestry.
+   * @param s Stand-in for state.
+   */
+  template<class V1>
+  static void copy(const V1 as, DeferredCopy& s);
+
   /**
    * Normalise log-weights after resampling.
    *
@@ -240,6 +271,19 @@ public:
   template<class V1>
   static void normalise(V1 lws);
 
+  /**
+   * Normalise log-weights, using precomputed statistics.
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param lws Log-weights.
+   * @param stats Statistics of @p lws.
+   *
+   * As normalise(V1), but avoids a reduction over @p lws.
+   */
+  template<class V1>
+  static void normalise(V1 lws, const WeightStatistics& stats);
+
   /**
    * Is ESS-based condition triggered?
    *
@@ -251,6 +295,20 @@ public:
   bool isTriggered(const V1 lws) const
       throw (ParticleFilterDegeneratedException);
 
+  /**
+   * Is ESS-based condition triggered, using precomputed statistics?
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param lws Log-weights.
+   * @param stats Statistics of @p lws.
+   *
+   * As isTriggered(const V1), but avoids a reduction over @p lws.
+   */
+  template<class V1>
+  bool isTriggered(const V1 lws, const WeightStatistics& stats) const
+      throw (ParticleFilterDegeneratedException);
+
   /**
    * Compute effective sample size (ESS) of log-weights.
    *
@@ -339,6 +397,12 @@ public:
    */
   template<class V1>
   static void permute(V1 as);
+
+  /**
+   * @copydoc Resampler::copy(const V1, M1)
+   */
+  template<class V1, class M1>
+  static void copy(const V1 as, M1 X);
 };
 
 /**
@@ -398,6 +462,12 @@ public:
   template<class V1>
   static void permute(V1 as);
 
+  /**
+   * @copydoc Resampler::copy(const V1, M1)
+   */
+  template<class V1, class M1>
+  static void copy(const V1 as, M1 X);
+
   /**
    * First stage of permutation.
    *
@@ -507,13 +577,17 @@ void bi::Resampler::correct(const V1 as, const V2 qlws, V3 lws) {
 
 template<class V1, class M1>
 void bi::Resampler::copy(const V1 as, M1 s) {
-  gather_rows(as, s, s);
+  typedef typename boost::mpl::if_c<M1::on_device,ResamplerGPU,ResamplerHost>::type impl;
+  impl::copy(as, s);
 }
 
 template<class V1, class B, bi::Location L>
 void bi::Resampler::copy(const V1 as, State<B,L>& s) {
   s.setRange(s.start(), bi::max(s.size(), as.size()));
   copy(as, s.getDyn());
+  if (s.getOde().size2() > 0) {
+    copy(as, s.getOde());
+  }
   s.setRange(s.start(), as.size());
 }
 
@@ -534,6 +608,11 @@ void bi::Resampler::copy(const V1 as, std::vector<T1*>& v) {
   }
 }
 
+template<class V1>
+inline void bi::Resampler::copy(const V1 as, DeferredCopy& s) {
+  //
+}
+
 template<class V1>
 void bi::Resampler::normalise(V1 lws) {
   typedef typename V1::value_type T1;
@@ -541,12 +620,34 @@ void bi::Resampler::normalise(V1 lws) {
   addscal_elements(lws, bi::log(static_cast<T1>(lws.size())) - lW, lws);
 }
 
+template<class V1>
+void bi::Resampler::normalise(V1 lws, const WeightStatistics& stats) {
+  typedef typename V1::value_type T1;
+  T1 lW = stats.logSum();
+  addscal_elements(lws, bi::log(static_cast<T1>(lws.size())) - lW, lws);
+}
+
 template<class V1>
 bool bi::Resampler::isTriggered(const V1 lws) const
     throw (ParticleFilterDegeneratedException) {
   return essRel >= 1.0 || ess(lws) < essRel * lws.size();
 }
 
+template<class V1>
+bool bi::Resampler::isTriggered(const V1 lws, const WeightStatistics& stats)
+    const throw (ParticleFilterDegeneratedException) {
+  if (essRel >= 1.0) {
+    return true;
+  } else {
+    real ess = stats.ess();
+    if (ess > 0.0) {
+      return ess < essRel * lws.size();
+    } else {
+      throw ParticleFilterDegeneratedException();
+    }
+  }
+}
+
 template<class V1>
 typename V1::value_type bi::Resampler::ess(const V1 lws)
     throw (ParticleFilterDegeneratedException) {
@@ -166,6 +166,15 @@ protected:
    */
   bool sort;
 };
+
+/**
+ * @internal
+ */
+template<>
+struct resampler_can_defer_copy<StratifiedResampler> {
+  static const bool value = true;
+};
+
 }
 
 #include "../host/resampler/StratifiedResamplerHost.hpp"
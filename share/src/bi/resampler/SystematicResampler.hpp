@@ -166,6 +166,15 @@ protected:
    */
   bool sort;
 };
+
+/**
+ * @internal
+ */
+template<>
+struct resampler_can_defer_copy<SystematicResampler> {
+  static const bool value = true;
+};
+
 }
 
 #include "../primitive/vector_primitive.hpp"
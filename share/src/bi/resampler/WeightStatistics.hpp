@@ -0,0 +1,132 @@
+/**
+ * @file
+ *
+ * @author Lawrence Murray <lawrence.murray@csiro.au>
+ * $Rev$
+ * $Date$
+ */
+#ifndef BI_RESAMPLER_WEIGHTSTATISTICS_HPP
+#define BI_RESAMPLER_WEIGHTSTATISTICS_HPP
+
+#include "../math/scalar.hpp"
+#include "../misc/assert.hpp"
+
+namespace bi {
+/**
+ * Summary statistics of log-weights.
+ *
+ * @ingroup method_resampler
+ *
+ * Holds the maximum of a vector of log-weights, along with the sums of
+ * weights and squared weights relative to that maximum, as computed by
+ * weight_stats_reduce(). The log of the sum of weights, needed for the
+ * incremental log-likelihood and for normalisation, and the effective
+ * sample size (ESS), needed to trigger resampling, both follow without
+ * further passes over the log-weights.
+ *
+ * The statistics describe the log-weights given to the last call of
+ * update(). Whoever modifies those log-weights otherwise should call
+ * invalidate().
+ */
+class WeightStatistics {
+public:
+  /**
+   * Constructor. The statistics are initially invalid.
+   */
+  WeightStatistics();
+
+  /**
+   * Update statistics.
+   *
+   * @tparam V1 Vector type.
+   *
+   * @param lws Log-weights.
+   */
+  template<class V1>
+  void update(const V1 lws);
+
+  /**
+   * Invalidate statistics.
+   */
+  void invalidate();
+
+  /**
+   * Are statistics valid?
+   */
+  bool isValid() const;
+
+  /**
+   * Log of the sum of weights.
+   */
+  real logSum() const;
+
+  /**
+   * Effective sample size.
+   */
+  real ess() const;
+
+private:
+  /**
+   * Maximum log-weight.
+   */
+  real mx;
+
+  /**
+   * Sum of weights, relative to maximum.
+   */
+  real sum1;
+
+  /**
+   * Sum of squared weights, relative to maximum.
+   */
+  real sum2;
+
+  /**
+   * Are statistics valid?
+   */
+  bool valid;
+};
+}
+
+#include "../primitive/vector_primitive.hpp"
+#include "../math/function.hpp"
+
+inline bi::WeightStatistics::WeightStatistics() :
+    mx(0.0), sum1(0.0), sum2(0.0), valid(false) {
+  //
+}
+
+template<class V1>
+inline void bi::WeightStatistics::update(const V1 lws) {
+  typename V1::value_type mx1, sum11, sum21;
+
+  weight_stats_reduce(lws, mx1, sum11, sum21);
+  mx = mx1;
+  sum1 = sum11;
+  sum2 = sum21;
+  valid = true;
+}
+
+inline void bi::WeightStatistics::invalidate() {
+  valid = false;
+}
+
+inline bool bi::WeightStatistics::isValid() const {
+  return valid;
+}
+
+inline real bi::WeightStatistics::logSum() const {
+  /* pre-condition */
+  BI_ASSERT(valid);
+
+  return mx + bi::log(sum1);
+}
+
+inline real bi::WeightStatistics::ess() const {
+  /* pre-condition */
+  BI_ASSERT(valid);
+
+  return (sum1*sum1)/sum2;
+}
+
+#endif
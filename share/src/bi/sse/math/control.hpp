@@ -27,11 +27,16 @@ sse_real sse_if(const sse_real& mask, const sse_real& o1,
  * Any.
  *
  * @return True if any mask components are true, false otherwise.
- *
- * @todo Is there a reduction intrinsic for this in SSE3?
  */
 bool sse_any(const sse_real& mask);
 
+/**
+ * All.
+ *
+ * @return True if all mask components are true, false otherwise.
+ */
+bool sse_all(const sse_real& mask);
+
 }
 
 inline bi::sse_real bi::sse_if(const bi::sse_real& mask,
@@ -41,17 +46,11 @@ inline bi::sse_real bi::sse_if(const bi::sse_real& mask,
 }
 
 inline bool bi::sse_any(const bi::sse_real& mask) {
-  bool result = false;
-  #ifdef ENABLE_SINGLE
-  CUDA_ALIGN(16) int x[BI_SSE_SIZE] BI_ALIGN(16);
-  #else
-  CUDA_ALIGN(16) long x[BI_SSE_SIZE] BI_ALIGN(16);
-  #endif
-  BI_SSE_STORE_P(reinterpret_cast<real*>(x), mask.packed);
-  for (int i = 0; !result && i < BI_SSE_SIZE; ++i) {
-    result = result || x[i];
-  }
-  return result;
+  return BI_SSE_MOVEMASK_P(mask.packed) != 0;
+}
+
+inline bool bi::sse_all(const bi::sse_real& mask) {
+  return BI_SSE_MOVEMASK_P(mask.packed) == (1 << BI_SSE_SIZE) - 1;
 }
 
 #endif
@@ -69,6 +69,7 @@
 #define BI_SSE_ANDNOT_P _mm_andnot_ps
 #define BI_SSE_XOR_P _mm_xor_ps
 #define BI_SSE_HADD_P _mm_hadd_ps
+#define BI_SSE_MOVEMASK_P _mm_movemask_ps
 #define BI_SSE_ROTATE_LEFT(x) BI_SSE_SHUFFLE_P(x, x, _MM_SHUFFLE(0,3,2,1))
 #else
 #define BI_SSE_ADD_S _mm_add_sd
@@ -112,6 +113,7 @@
 #define BI_SSE_ANDNOT_P _mm_andnot_pd
 #define BI_SSE_XOR_P _mm_xor_pd
 #define BI_SSE_HADD_P _mm_hadd_pd // horizontal add
+#define BI_SSE_MOVEMASK_P _mm_movemask_pd
 #define BI_SSE_ROTATE_LEFT(x) BI_SSE_SHUFFLE_P(x, x, _MM_SHUFFLE(1,0,3,2))
 #endif
 #define BI_SSE_PREFETCH _mm_prefetch
@@ -137,6 +139,14 @@ namespace bi {
     sse_real(const __m128 x) : packed(x) {
       //
     }
+
+    real& operator[](const int i) {
+      return reinterpret_cast<real*>(&unpacked)[i];
+    }
+
+    const real& operator[](const int i) const {
+      return reinterpret_cast<const real*>(&unpacked)[i];
+    }
     #else
     struct {
       real a, b;
@@ -160,6 +170,14 @@ namespace bi {
       }
     }
 
+    const real& operator[](const int i) const {
+      if (i == 0) {
+        return unpacked.a;
+      } else {
+        return unpacked.b;
+      }
+    }
+
     #endif
 
     sse_real() {
@@ -11,6 +11,12 @@
 namespace bi {
 /**
  * @copydoc DOPRI5Integrator
+ *
+ * Each lane integrates a different trajectory, with its own time and step
+ * size. A lane that finishes is refilled with the next trajectory from a
+ * queue shared by all threads, so that trajectories requiring many steps do
+ * not hold back those in other lanes. The step size of each trajectory is
+ * kept between calls (see IntegratorState).
  */
 template<class B, class S, class T1>
 class DOPRI5IntegratorSSE {
@@ -27,10 +33,14 @@ public:
 #include "../math/control.hpp"
 #include "../../host/ode/DOPRI5VisitorHost.hpp"
 #include "../../host/ode/IntegratorConstants.hpp"
+#include "../../host/ode/IntegratorDiagnostics.hpp"
+#include "../../host/ode/IntegratorState.hpp"
 #include "../../state/Pa.hpp"
 #include "../../typelist/front.hpp"
 #include "../../typelist/pop_front.hpp"
 
+#include "boost/typeof/typeof.hpp"
+
 template<class B, class S, class T1>
 void bi::DOPRI5IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
@@ -39,13 +49,23 @@ void bi::DOPRI5IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
 
   typedef host_vector_reference<sse_real> vector_reference_type;
   typedef Pa<ON_HOST,B,host,host,sse_host,sse_host> PX;
-  typedef DOPRI5VisitorHost<B,S,S,real,PX,sse_real> Visitor;
+  typedef DOPRI5VisitorHost<B,S,S,sse_real,PX,sse_real> Visitor;
+  typedef IntegratorState<B,S> Persist;
   static const int N = block_size<S>::value;
   const int P = s.size();
+  int next = 0; // next trajectory in queue
+
+  Persist::init(s);
+  BOOST_AUTO(O, s.getOde());
+
+  #ifdef ENABLE_DIAGNOSTICS
+  IntegratorDiagnostics diagnostics("DOPRI5IntegratorSSE");
+  #endif
 
   #pragma omp parallel
   {
-    sse_real buf[10*N];
+    State<B,ON_HOST> x(BI_SSE_SIZE); // one trajectory in each lane
+    sse_real buf[11*N];
     vector_reference_type x0(buf, N);
     vector_reference_type x1(buf + N, N);
     vector_reference_type x2(buf + 2*N, N);
@@ -56,96 +76,136 @@ void bi::DOPRI5IntegratorSSE<B,S,T1>::update(const T1 t1, const T1 t2,
     vector_reference_type err(buf + 7*N, N);
     vector_reference_type k1(buf + 8*N, N);
     vector_reference_type k7(buf + 9*N, N);
+    vector_reference_type dense(buf + 10*N, N);
 
-    sse_real e, e2;
-    real t, h, logfacold, logfac11, fac, e2max;
-    int n, id, p;
-    bool k1in;
+    sse_real t, h, hprop, e, e2, logfacold, logfac11, fac, accept;
+    int q[BI_SSE_SIZE], n[BI_SSE_SIZE];
+    int id, k, active;
+    real hk, logfacoldk;
+    bool empty = false, refill, k1in = false;
     PX pax;
+    #ifdef ENABLE_DIAGNOSTICS
+    long steps = 0;
+    #endif
+
+    x.getCommon() = s.getCommon();
+    for (k = 0; k < BI_SSE_SIZE; ++k) {
+      q[k] = -1;
+      t[k] = t2;
+      h[k] = BI_REAL(0.0);
+    }
 
-    #pragma omp for
-    for (p = 0; p < P; p += BI_SSE_SIZE) {
-      t = t1;
-      h = h_h0;
-      logfacold = bi::log(BI_REAL(1.0e-4));
-      k1in = false;
-      n = 0;
-      sse_host_load<B,S>(s, p, x0);
-
-      /* integrate */
-      while (t < t2 && n < h_nsteps) {
-        if (BI_REAL(0.1)*bi::abs(h) <= bi::abs(t)*h_uround) {
-          // step size too small
+    while (true) {
+      /* retire lanes that have finished, refill from queue */
+      refill = false;
+      active = 0;
+      for (k = 0; k < BI_SSE_SIZE; ++k) {
+        if (q[k] >= 0 && (t[k] >= t2 || n[k] >= h_nsteps)) {
+          row(s.getTraj(), q[k]) = row(x.getTraj(), k);
+          hk = (t[k] >= t2) ? bi::max(h[k], hprop[k]) : h[k];
+          logfacoldk = logfacold[k];
+          Persist::store(row(O, q[k]), hk, logfacoldk);
+          #ifdef ENABLE_DIAGNOSTICS
+          steps += n[k];
+          #endif
+          q[k] = -1;
         }
-        if (t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0)) {
-          h = t2 - t;
-          if (h <= BI_REAL(0.0)) {
-            t = t2;
-            break;
+        if (q[k] < 0 && !empty) {
+          #pragma omp atomic capture
+          q[k] = next++;
+
+          if (q[k] < P) {
+            row(x.getTraj(), k) = row(s.getTraj(), q[k]);
+            t[k] = t1;
+            Persist::load(row(O, q[k]), hk, logfacoldk);
+            h[k] = hk;
+            logfacold[k] = logfacoldk;
+            n[k] = 0;
+            refill = true;
+          } else {
+            q[k] = -1;
+            empty = true;
           }
         }
+        if (q[k] >= 0) {
+          ++active;
+        } else {
+          /* idle lane, zero step leaves it unchanged */
+          t[k] = t2;
+          h[k] = BI_REAL(0.0);
+        }
+      }
+      if (active == 0) {
+        break;
+      }
+      if (refill) {
+        /* k1 of remaining lanes is recomputed too, which is harmless */
+        sse_host_load<B,S>(x, 0, x0);
+        k1in = false;
+      }
 
-        /* stages */
-        Visitor::stage1(t, h, s, p, pax, x0.buf(), x1.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), k1.buf(), err.buf(), k1in);
-        k1in = true; // can reuse from previous iteration in future
-        sse_host_store<B,S>(s, p, x1);
+      /* truncate last step of each lane at end of interval, keeping the
+       * step size proposed before truncation */
+      hprop = h;
+      h = sse_if(t + BI_REAL(1.01)*h - t2 > BI_REAL(0.0), t2 - t, h);
 
-        Visitor::stage2(t, h, s, p, pax, x0.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
-        sse_host_store<B,S>(s, p, x2);
+      /* stages */
+      Visitor::stage1(t, h, x, 0, pax, x0.buf(), x1.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), k1.buf(), err.buf(), dense.buf(), k1in);
+      k1in = true; // can reuse from previous iteration in future
+      sse_host_store<B,S>(x, 0, x1);
 
-        Visitor::stage3(t, h, s, p, pax, x0.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
-        sse_host_store<B,S>(s, p, x3);
+      Visitor::stage2(t, h, x, 0, pax, x0.buf(), x2.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
+      sse_host_store<B,S>(x, 0, x2);
 
-        Visitor::stage4(t, h, s, p, pax, x0.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf());
-        sse_host_store<B,S>(s, p, x4);
+      Visitor::stage3(t, h, x, 0, pax, x0.buf(), x3.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
+      sse_host_store<B,S>(x, 0, x3);
 
-        Visitor::stage5(t, h, s, p, pax, x0.buf(), x5.buf(), x6.buf(), err.buf());
-        sse_host_store<B,S>(s, p, x5);
+      Visitor::stage4(t, h, x, 0, pax, x0.buf(), x4.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
+      sse_host_store<B,S>(x, 0, x4);
 
-        Visitor::stage6(t, h, s, p, pax, x0.buf(), x6.buf(), err.buf());
+      Visitor::stage5(t, h, x, 0, pax, x0.buf(), x5.buf(), x6.buf(), err.buf(), dense.buf());
+      sse_host_store<B,S>(x, 0, x5);
 
-        /* compute error */
-        Visitor::stageErr(t, h, s, p, pax, x0.buf(), x6.buf(), k7.buf(), err.buf());
+      Visitor::stage6(t, h, x, 0, pax, x0.buf(), x6.buf(), err.buf(), dense.buf());
 
-        /* determine largest error among trajectories */
-        e2 = BI_REAL(0.0);
-        for (id = 0; id < N; ++id) {
-          e = err[id]*h/(bi::max(bi::abs(x0(id)), bi::abs(x6(id)))*h_rtoler + h_atoler);
-          e2 += e*e;
-        }
-        #ifdef ENABLE_SINGLE
-        e2max = bi::max(bi::max(e2.unpacked.a, e2.unpacked.b), bi::max(e2.unpacked.c, e2.unpacked.d));
-        #else
-        e2max = bi::max(e2.unpacked.a, e2.unpacked.b);
-        #endif
-        e2max /= N;
-
-        if (e2max <= BI_REAL(1.0)) {
-          /* accept */
-          t += h;
-          x0.swap(x6);
-          k1.swap(k7);
-        }
-        sse_host_store<B,S>(s, p, x0);
-
-        /* compute next step size */
-        if (t < t2) {
-          logfac11 = h_expo*bi::log(e2max);
-          if (e2max > BI_REAL(1.0)) {
-            /* step was rejected */
-            h *= bi::max(h_facl, bi::exp(h_logsafe - logfac11));
-          } else {
-            /* step was accepted */
-            fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
-            fac = bi::min(h_facr, bi::max(h_facl, fac)); // bound
-            h *= fac;
-            logfacold = BI_REAL(0.5)*bi::log(bi::max(e2max, BI_REAL(1.0e-8)));
-          }
-        }
+      /* compute error */
+      Visitor::stageErr(t, h, x, 0, pax, x0.buf(), x6.buf(), k7.buf(), err.buf(), dense.buf());
 
-        ++n;
+      /* compute error of each lane */
+      e2 = BI_REAL(0.0);
+      for (id = 0; id < N; ++id) {
+        e = err[id]*h/(bi::max(bi::abs(x0(id)), bi::abs(x6(id)))*h_rtoler + h_atoler);
+        e2 += e*e;
+      }
+      e2 /= BI_REAL(N);
+
+      /* accept or reject each lane */
+      accept = e2 <= BI_REAL(1.0);
+      t = sse_if(accept, t + h, t);
+      for (id = 0; id < N; ++id) {
+        x0(id) = sse_if(accept, x6(id), x0(id));
+        k1(id) = sse_if(accept, k7(id), k1(id));
+      }
+      sse_host_store<B,S>(x, 0, x0);
+
+      /* compute next step size of each lane; packed max and min return the
+       * second argument if either is NaN, so a NaN error shrinks by facl */
+      logfac11 = h_expo*bi::log(e2);
+      fac = bi::exp(h_beta*logfacold + h_logsafe - logfac11); // Lund-stabilization
+      fac = bi::min(bi::max(fac, h_facl), h_facr); // bound
+      h *= sse_if(accept, fac, bi::max(bi::exp(h_logsafe - logfac11), h_facl));
+      logfacold = sse_if(accept, BI_REAL(0.5)*bi::log(bi::max(e2, BI_REAL(1.0e-8))), logfacold);
+
+      for (k = 0; k < BI_SSE_SIZE; ++k) {
+        if (q[k] >= 0) {
+          ++n[k];
+        }
       }
     }
+
+    #ifdef ENABLE_DIAGNOSTICS
+    diagnostics.record(steps);
+    #endif
   }
 }
 
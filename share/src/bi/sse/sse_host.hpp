@@ -192,11 +192,35 @@ void sse_host_load(State<B,ON_HOST>& s, const int p, V1 x);
 template<class B, class S, class V1>
 void sse_host_store(State<B,ON_HOST>& s, const int p, const V1 x);
 
+/**
+ * Number of trajectories that may be processed with SSE instructions.
+ *
+ * @tparam B Model type.
+ *
+ * @param s State.
+ *
+ * @return Largest multiple of #BI_SSE_SIZE not greater than the number of
+ * trajectories in the active range of @p s, or zero if the start of that
+ * range is not aligned. The remaining tail of the range should be
+ * processed without SSE instructions.
+ */
+template<class B>
+int sse_host_size(const State<B,ON_HOST>& s);
+
 }
 
 #include "sse_host_load_visitor.hpp"
 #include "sse_host_store_visitor.hpp"
 
+template<class B>
+inline int bi::sse_host_size(const State<B,ON_HOST>& s) {
+  if (s.start() % BI_SSE_SIZE == 0) {
+    return s.size() - s.size() % BI_SSE_SIZE;
+  } else {
+    return 0;
+  }
+}
+
 template<class B, class X>
 inline bi::sse_host::vector_reference_type bi::sse_host::fetch(
     State<B,ON_HOST>& s, const int p) {
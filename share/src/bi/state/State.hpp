@@ -18,6 +18,15 @@
 
 #include "boost/serialization/split_member.hpp"
 
+/**
+ * @def BI_STATE_ALIGN
+ *
+ * Alignment, in bytes, of each column of storage for non-shared variables
+ * on host, when SSE is enabled. This is the length of a cache line, and a
+ * multiple of the width of all vector registers.
+ */
+#define BI_STATE_ALIGN 64
+
 namespace bi {
 /**
  * %State of Model %model.
@@ -99,8 +108,9 @@ public:
    *
    * Resizes the state to store at least @p P number of trajectories.
    * Storage for additional trajectories may be added in some contexts,
-   * see #roundup. The active range will be set to the full buffer, with
-   * previously active trajectories optionally preserved.
+   * see #roundup and #padup. The active range will be set to the first
+   * <tt>roundup(P)</tt> trajectories of the buffer, with previously active
+   * trajectories optionally preserved.
    */
   void resize(const int P, const bool preserve = true);
 
@@ -119,12 +129,23 @@ public:
    *
    * Resizes the state to store at least @p maxP number of trajectories.
    * Storage for additional trajectories may be added in some contexts,
-   * see #roundup. This affects the maximum size (see #maxSize), but not
-   * the number of trajectories currently active (see #size and #setRange).
-   * The active range of trajectories will be shrunk if necessary.
+   * see #roundup and #padup. This affects the maximum size (see #maxSize),
+   * but not the number of trajectories currently active (see #size and
+   * #setRange). The active range of trajectories will be shrunk if
+   * necessary.
    */
   void resizeMax(const int maxP, const bool preserve = true);
 
+  /**
+   * Swap contents with another state.
+   *
+   * @param o State.
+   *
+   * Buffers, along with the active range of each state, are exchanged by
+   * pointer swap, no data is copied.
+   */
+  void swap(State<B,L>& o);
+
   /**
    * Clear.
    */
@@ -286,6 +307,61 @@ public:
   CUDA_FUNC_BOTH
   const matrix_reference_type getDyn() const;
 
+  /**
+   * Get buffer of all variables with a value for each trajectory: those of
+   * #getDyn, and obs, state_aux_ and alternative variables.
+   */
+  CUDA_FUNC_BOTH
+  matrix_reference_type getTraj();
+
+  /**
+   * Get buffer of all variables with a value for each trajectory.
+   */
+  CUDA_FUNC_BOTH
+  const matrix_reference_type getTraj() const;
+
+  /**
+   * Get buffer of adaptive ODE integrator state, kept for each trajectory
+   * between calls to the integrators. It is cleared at the start of each
+   * run (see Simulator::init()), so that runs do not depend on those
+   * before them.
+   *
+   * The buffer has no columns until resized with #resizeOde. The layout of
+   * each row is up to the integrator.
+   */
+  matrix_reference_type getOde();
+
+  /**
+   * Get buffer of adaptive ODE integrator state.
+   */
+  const matrix_reference_type getOde() const;
+
+  /**
+   * Widen buffer of adaptive ODE integrator state.
+   *
+   * @param N Minimum number of columns.
+   *
+   * Columns added are zeroed, existing columns are preserved.
+   */
+  void resizeOde(const int N);
+
+  /**
+   * Are trajectories continuous past the end of the current time interval?
+   *
+   * @return True if nothing but the integration of ODEs is applied to
+   * trajectories between the current time interval and the next, so that an
+   * integrator may step past the end of the current interval and carry
+   * that step into the next, false otherwise.
+   */
+  CUDA_FUNC_BOTH
+  bool isContinuous() const;
+
+  /**
+   * Set whether trajectories are continuous past the end of the current
+   * time interval. See #isContinuous.
+   */
+  void setContinuous(const bool continuous);
+
   /**
    * Round up number of trajectories as required by implementation.
    *
@@ -297,11 +373,29 @@ public:
    *
    * @li for @p L on device, @p P must be either less than 32, or a
    * multiple of 32, and
-   * @li for @p L on host with SSE enabled, @p P must be zero, one or a
-   * multiple of four (single precision) or two (double precision).
+   * @li for @p L on host, any @p P is permitted.
+   *
+   * On host, storage is instead padded (see #padup), so that vectorised
+   * kernels apply to any number of trajectories, processing a scalar tail
+   * where that number is not a multiple of the vector width.
    */
   static CUDA_FUNC_BOTH int roundup(const int P);
 
+  /**
+   * Round up number of rows of storage, for alignment.
+   *
+   * @param P Number of trajectories.
+   *
+   * @return Number of rows of storage.
+   *
+   * For @p L on host with SSE enabled, storage is padded so that each
+   * column begins on a #BI_STATE_ALIGN byte boundary. The padding lies
+   * outside of the active range, and is never read or written by
+   * vectorised kernels, which only operate on whole vectors within that
+   * range. Otherwise there is no padding.
+   */
+  static CUDA_FUNC_BOTH int padup(const int P);
+
 private:
   /**
    * Storage for dense non-shared variables.
@@ -313,6 +407,16 @@ private:
    */
   matrix_type Kdn;
 
+  /**
+   * Storage for adaptive ODE integrator state.
+   */
+  matrix_type Idn;
+
+  /**
+   * Are trajectories continuous past the end of the current time interval?
+   */
+  bool continuous;
+
   /**
    * Index of starting trajectory in @p Xdn.
    */
@@ -359,15 +463,18 @@ private:
 
 template<class B, bi::Location L>
 bi::State<B,L>::State(const int P) :
-    Xdn(roundup(P), NR + ND + NO + NDX + NR + ND),  // includes dy- and ry-vars
+    Xdn(padup(roundup(P)), NR + ND + NO + NDX + NR + ND),  // includes dy- and ry-vars
     Kdn(1, NP + NPX + NF + NP + NO),  // includes py- and oy-vars
+    Idn(padup(roundup(P)), 0),
+    continuous(false),
     p(0), P(roundup(P)) {
   clear();
 }
 
 template<class B, bi::Location L>
 bi::State<B,L>::State(const State<B,L>& o) :
-    Xdn(o.Xdn), Kdn(o.Kdn), p(o.p), P(o.P) {
+    Xdn(o.Xdn), Kdn(o.Kdn), Idn(o.Idn), continuous(o.continuous), p(o.p),
+    P(o.P) {
   //
 }
 
@@ -375,6 +482,11 @@ template<class B, bi::Location L>
 bi::State<B,L>& bi::State<B,L>::operator=(const State<B,L>& o) {
   rows(Xdn, p, P) = rows(o.Xdn, o.p, o.P);
   Kdn = o.Kdn;
+  if (o.Idn.size2() > 0) {
+    resizeOde(o.Idn.size2());
+    subrange(Idn, p, P, 0, o.Idn.size2()) = rows(o.Idn, o.p, o.P);
+  }
+  continuous = o.continuous;
 
   return *this;
 }
@@ -384,6 +496,11 @@ template<bi::Location L2>
 bi::State<B,L>& bi::State<B,L>::operator=(const State<B,L2>& o) {
   rows(Xdn, p, P) = rows(o.Xdn, o.p, o.P);
   Kdn = o.Kdn;
+  if (o.Idn.size2() > 0) {
+    resizeOde(o.Idn.size2());
+    subrange(Idn, p, P, 0, o.Idn.size2()) = rows(o.Idn, o.p, o.P);
+  }
+  continuous = o.continuous;
 
   return *this;
 }
@@ -422,12 +539,15 @@ inline void bi::State<B,L>::resize(const int P, const bool preserve) {
     while (p < N - n) {
       /* be careful of overlap */
       rows(Xdn, n, p) = rows(Xdn, p + n, p);
+      rows(Idn, n, p) = rows(Idn, p + n, p);
       n += p;
     }
     rows(Xdn, n, N - n) = rows(Xdn, p + n, N - n);
+    rows(Idn, n, N - n) = rows(Idn, p + n, N - n);
   }
 
-  Xdn.resize(P1, Xdn.size2(), preserve);
+  Xdn.resize(padup(P1), Xdn.size2(), preserve);
+  Idn.resize(padup(P1), Idn.size2(), preserve);
   p = 0;
   this->P = P1;
 }
@@ -441,7 +561,8 @@ template<class B, bi::Location L>
 inline void bi::State<B,L>::resizeMax(const int maxP, const bool preserve) {
   const int maxP1 = roundup(maxP);
 
-  Xdn.resize(maxP1, Xdn.size2(), preserve);
+  Xdn.resize(padup(maxP1), Xdn.size2(), preserve);
+  Idn.resize(padup(maxP1), Idn.size2(), preserve);
   if (p > sizeMax()) {
     p = sizeMax();
   }
@@ -450,10 +571,21 @@ inline void bi::State<B,L>::resizeMax(const int maxP, const bool preserve) {
   }
 }
 
+template<class B, bi::Location L>
+inline void bi::State<B,L>::swap(State<B,L>& o) {
+  Xdn.swap(o.Xdn);
+  Kdn.swap(o.Kdn);
+  Idn.swap(o.Idn);
+  std::swap(continuous, o.continuous);
+  std::swap(p, o.p);
+  std::swap(P, o.P);
+}
+
 template<class B, bi::Location L>
 inline void bi::State<B,L>::clear() {
   rows(Xdn, 0, P).clear();
   Kdn.clear();
+  rows(Idn, 0, P).clear();
 }
 
 template<class B, bi::Location L>
@@ -733,6 +865,45 @@ inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getD
   return subrange(Xdn.ref(), p, P, 0, NR + ND);
 }
 
+template<class B, bi::Location L>
+inline typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getTraj() {
+  return rows(Xdn.ref(), p, P);
+}
+
+template<class B, bi::Location L>
+inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getTraj() const {
+  return rows(Xdn.ref(), p, P);
+}
+
+template<class B, bi::Location L>
+inline typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getOde() {
+  return rows(Idn.ref(), p, P);
+}
+
+template<class B, bi::Location L>
+inline const typename bi::State<B,L>::matrix_reference_type bi::State<B,L>::getOde() const {
+  return rows(Idn.ref(), p, P);
+}
+
+template<class B, bi::Location L>
+void bi::State<B,L>::resizeOde(const int N) {
+  const int N1 = Idn.size2();
+  if (N > N1) {
+    Idn.resize(Xdn.size1(), N, true);
+    columns(Idn, N1, N - N1).clear();
+  }
+}
+
+template<class B, bi::Location L>
+inline bool bi::State<B,L>::isContinuous() const {
+  return continuous;
+}
+
+template<class B, bi::Location L>
+inline void bi::State<B,L>::setContinuous(const bool continuous) {
+  this->continuous = continuous;
+}
+
 template<class B, bi::Location L>
 int bi::State<B,L>::roundup(const int P) {
   int P1 = P;
@@ -741,15 +912,21 @@ int bi::State<B,L>::roundup(const int P) {
     if (P1 > 32) {
       P1 = ((P1 + 31) / 32) * 32;
     }
-  } else {
+  }
+
+  return P1;
+}
+
+template<class B, bi::Location L>
+int bi::State<B,L>::padup(const int P) {
+  int P1 = P;
 #ifdef ENABLE_SSE
-    /* zero, one or a multiple of 4 (single precision) or 2 (double
-     * precision) required */
-    if (P1 > 1) {
-      P1 = ((P1 + BI_SSE_SIZE - 1)/BI_SSE_SIZE)*BI_SSE_SIZE;
-    }
-#endif
+  if (L == ON_HOST) {
+    /* each column aligned */
+    const int N = BI_STATE_ALIGN/sizeof(real);
+    P1 = ((P1 + N - 1)/N)*N;
   }
+#endif
 
   return P1;
 }
@@ -770,6 +947,10 @@ void bi::State<B,L>::load(Archive& ar, const unsigned version) {
   load_resizable_matrix(ar, version, Kdn);
   ar & p;
   ar & P;
+
+  /* integrator state is not serialized, integrators start afresh */
+  Idn.resize(Xdn.size1(), 0, false);
+  continuous = false;
 }
 
 #endif
@@ -15,6 +15,7 @@
 #include "../typelist/size.hpp"
 #include "../typelist/contains.hpp"
 #include "../typelist/equals.hpp"
+#include "../cuda/cuda.hpp"
 
 namespace bi {
 /**
@@ -122,6 +123,56 @@ struct block_is_matrix<empty_typelist> {
   static const bool value = true;
 };
 
+/**
+ * Position of an element of a target in block.
+ *
+ * @ingroup model_low
+ *
+ * @tparam S Action type list.
+ * @tparam X Target type.
+ */
+template<class S, class X>
+struct block_index {
+  /**
+   * Get position.
+   *
+   * @param ix Serial index of element within the target.
+   *
+   * @return Position of the element among the targets of the block, as
+   * ordered by action_start, or -1 if the element is not a target of the
+   * block.
+   */
+  static CUDA_FUNC_BOTH int index(const int ix) {
+    typedef typename front<S>::type front;
+    typedef typename pop_front<S>::type pop_front;
+    typedef typename front::target_type target_type;
+    typedef typename front::coord_type coord_type;
+
+    int j = equals<target_type,X>::value ? coord_type::subIndex(ix) : -1;
+    if (j < 0) {
+      j = block_index<pop_front,X>::index(ix);
+      if (j >= 0) {
+        j += action_size<front>::value;
+      }
+    }
+    return j;
+  }
+};
+
+/**
+ * @internal
+ *
+ * Base case of block_index.
+ *
+ * @ingroup model_low
+ */
+template<class X>
+struct block_index<empty_typelist,X> {
+  static CUDA_FUNC_BOTH int index(const int ix) {
+    return -1;
+  }
+};
+
 }
 
 #endif
@@ -31,6 +31,20 @@ template<class R>
 struct resampler_needs_max {
   static const bool value = false;
 };
+
+/**
+ * Can resampler defer the copy of particles to the caller?
+ *
+ * @ingroup method_resampler
+ *
+ * A resampler for which this is true touches the state only through
+ * Resampler::copy(), so that a DeferredCopy may be passed in place of the
+ * state, and the copy fused with subsequent operations.
+ */
+template<class R>
+struct resampler_can_defer_copy {
+  static const bool value = false;
+};
 }
 
 #endif
@@ -80,6 +80,9 @@ public:
 #ifdef ENABLE_SSE
 #include "../sse/updater/DynamicUpdaterSSE.hpp"
 #endif
+#ifdef ENABLE_AVX
+#include "../avx/updater/DynamicUpdaterAVX.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/DynamicUpdaterGPU.cuh"
 #endif
@@ -89,12 +92,32 @@ template<class B, class S>
 template<class T1>
 void bi::DynamicUpdater<B,S>::update(const T1 t1, const T1 t2,
     State<B,ON_HOST>& s) {
-  #ifdef ENABLE_SSE
-  if (s.size() % BI_SSE_SIZE == 0) {
+  #if defined(ENABLE_AVX)
+  const int p = s.start(), P = s.size(), P1 = avx_host_size(s);
+
+  /* AVX over whole vectors, scalar over any remaining tail */
+  if (P1 > 0) {
+    s.setRange(p, P1);
+    DynamicUpdaterAVX<B,S>::update(t1, t2, s);
+  }
+  if (P1 < P) {
+    s.setRange(p + P1, P - P1);
+    DynamicUpdaterHost<B,S>::update(t1, t2, s);
+  }
+  s.setRange(p, P);
+  #elif defined(ENABLE_SSE)
+  const int p = s.start(), P = s.size(), P1 = sse_host_size(s);
+
+  /* SSE over whole vectors, scalar over any remaining tail */
+  if (P1 > 0) {
+    s.setRange(p, P1);
     DynamicUpdaterSSE<B,S>::update(t1, t2, s);
-  } else {
+  }
+  if (P1 < P) {
+    s.setRange(p + P1, P - P1);
     DynamicUpdaterHost<B,S>::update(t1, t2, s);
   }
+  s.setRange(p, P);
   #else
   DynamicUpdaterHost<B,S>::update(t1, t2, s);
   #endif
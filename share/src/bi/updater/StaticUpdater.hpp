@@ -58,6 +58,9 @@ public:
 #ifdef ENABLE_SSE
 #include "../sse/updater/StaticUpdaterSSE.hpp"
 #endif
+#ifdef ENABLE_AVX
+#include "../avx/updater/StaticUpdaterAVX.hpp"
+#endif
 #ifdef __CUDACC__
 #include "../cuda/updater/StaticUpdaterGPU.cuh"
 #endif
@@ -65,12 +68,32 @@ public:
 
 template<class B, class S>
 void bi::StaticUpdater<B,S>::update(State<B,ON_HOST>& s) {
-  #ifdef ENABLE_SSE
-  if (s.size() % BI_SSE_SIZE == 0) {
+  #if defined(ENABLE_AVX)
+  const int p = s.start(), P = s.size(), P1 = avx_host_size(s);
+
+  /* AVX over whole vectors, scalar over any remaining tail */
+  if (P1 > 0) {
+    s.setRange(p, P1);
+    StaticUpdaterAVX<B,S>::update(s);
+  }
+  if (P1 < P) {
+    s.setRange(p + P1, P - P1);
+    StaticUpdaterHost<B,S>::update(s);
+  }
+  s.setRange(p, P);
+  #elif defined(ENABLE_SSE)
+  const int p = s.start(), P = s.size(), P1 = sse_host_size(s);
+
+  /* SSE over whole vectors, scalar over any remaining tail */
+  if (P1 > 0) {
+    s.setRange(p, P1);
     StaticUpdaterSSE<B,S>::update(s);
-  } else {
+  }
+  if (P1 < P) {
+    s.setRange(p + P1, P - P1);
     StaticUpdaterHost<B,S>::update(s);
   }
+  s.setRange(p, P);
   #else
   StaticUpdaterHost<B,S>::update(s);
   #endif